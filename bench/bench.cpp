@@ -0,0 +1,123 @@
+/**
+ * @file bench.cpp
+ * @brief Headless benchmark of the sudoku resolution over a corpus of puzzles
+ * @author lhm
+ *
+ * The corpus is a text file with one puzzle per line (81 characters, '0' or '.' for an empty
+ * cell). Every puzzle is generated and solved \a repeat times, which is also the workload used
+ * to train profile-guided optimization builds.
+ *
+ * With the "portfolio" engine, the puzzles are raced by the Portfolio engines instead, and the
+ * number of wins of every engine is reported.
+ *
+ * With the "bitboard" engine, the puzzles are solved by BitBoard, and the number of explored nodes
+ * is reported (bench/corpus17.txt gathers the hardest, 17 clues, puzzles).
+ */
+
+// Project's headers
+#include "portfolio.h"
+
+// External headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::string> Puzzle;
+
+/*****************************************************************************/
+std::vector<Puzzle>
+load(const std::string& path)
+{
+    std::vector<Puzzle> ret;
+    std::ifstream       in{ path };
+
+    for (std::string line; std::getline(in, line);) {
+        if (81 > std::size(line))
+            continue;
+
+        Puzzle p(9, std::string(9, '0'));
+        for (size_t k{ 0 }; k < 81; ++k)
+            p[k / 9][k % 9] = ('1' <= line[k] && line[k] <= '9') ? line[k] : '0';
+        ret.emplace_back(std::move(p));
+    }
+
+    return ret;
+}
+
+} // namespace
+
+/*****************************************************************************/
+int
+main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <corpus> [repeat = 10] [max solutions = 1]"
+                     " [engine = ecv|portfolio|bitboard]\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto   puzzles{ load(argv[1]) };
+    const size_t repeat{ argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10 };
+    const size_t maxSols{ argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1 };
+    const auto   engine{ std::string{ argc > 4 ? argv[4] : "ecv" } };
+
+    if (std::empty(puzzles)) {
+        std::cerr << "No puzzle found in " << argv[1] << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if ("ecv" != engine && "portfolio" != engine && "bitboard" != engine) {
+        std::cerr << "Unknown engine " << engine << '\n';
+        return EXIT_FAILURE;
+    }
+
+    size_t     solved{ 0 }, nodes{ 0 };
+    Portfolio  engines;
+    const auto start{ std::chrono::steady_clock::now() };
+
+    for (size_t r{ 0 }; r < repeat; ++r) {
+        for (const auto& p : puzzles) {
+            if ("portfolio" == engine) {
+                solved += engines.solve(BitBoard::fromData(p)).solved ? 1 : 0;
+            } else if ("ecv" == engine) {
+                if (auto model{ ecv::Sudoku::generate(p) }; nullptr != model)
+                    solved += std::empty(model->solve(maxSols)) ? 0 : 1;
+            } else {
+                BitBoard solver{ BitBoard::fromData(p) };
+                solved += 0 == solver.solve(maxSols) ? 0 : 1;
+                nodes += solver.nodes();
+            }
+        }
+    }
+
+    const auto us{ std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count() };
+    const auto runs{ repeat * std::size(puzzles) };
+
+    std::cout << "puzzles: " << std::size(puzzles) << " x " << repeat << '\n'
+              << "solved:  " << solved << '/' << runs << '\n'
+              << "total:   " << us / 1000.0 << " ms\n"
+              << "average: " << (0 == runs ? 0.0 : static_cast<double>(us) / runs) << " us\n";
+
+    if ("bitboard" == engine)
+        std::cout << "nodes:   " << nodes << '\n';
+
+    if ("portfolio" == engine) {
+        const auto wins{ engines.wins() };
+        for (size_t e{ 0 }; e < Portfolio::EnginesCount; ++e)
+            std::cout << "wins (" << Portfolio::name(static_cast<Portfolio::Engine>(e))
+                      << "): " << wins[e] << '\n';
+    }
+
+    return solved == runs ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,48 @@
+#!/usr/bin/env sh
+#
+# Profile-guided optimization workflow, trained on the benchmark corpus.
+#
+# Usage : bench/pgo.sh [build root = ./_pgo] [extra cmake args...]
+#
+# Builds a plain Release, an instrumented one (ECV_SUDOKU_PGO=GENERATE) that is run on the corpus
+# with every engine to record the profiles, then rebuilds the same directory optimized
+# (ECV_SUDOKU_PGO=USE) so that the profiles match the objects whatever the compiler version, and
+# compares the plain and the optimized builds using the benchmark.
+#
+# With Clang, the recorded profiles are merged using llvm-profdata (or ${LLVM_PROFDATA}).
+
+set -e
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+ROOT=${1:-./_pgo}
+[ $# -gt 0 ] && shift
+CORPUS="${SRC}/bench/corpus.txt"
+REPEAT=${REPEAT:-50}
+LLVM_PROFDATA=${LLVM_PROFDATA:-llvm-profdata}
+PROFILES="$(mkdir -p "${ROOT}" && cd "${ROOT}" && pwd)/profiles"
+
+build() {
+    DIR="${ROOT}/$1"
+    PGO=$2
+    shift 2
+    cmake -S "${SRC}" -B "${DIR}" -DCMAKE_BUILD_TYPE=Release -DECV_SUDOKU_BENCH=ON \
+          -DECV_SUDOKU_LTO=ON -DECV_SUDOKU_PGO="${PGO}" -DECV_SUDOKU_PGO_DIR="${PROFILES}" "$@"
+    cmake --build "${DIR}" --target ecv-sudoku-bench ecv-sudoku -j
+}
+
+rm -rf "${PROFILES}"
+
+build release OFF "$@"
+build pgo GENERATE "$@"
+for engine in ecv portfolio bitboard; do
+    "${ROOT}/pgo/ecv-sudoku-bench" "${CORPUS}" "${REPEAT}" 1 "${engine}" > /dev/null
+done
+if ls "${PROFILES}"/*.profraw > /dev/null 2>&1; then
+    "${LLVM_PROFDATA}" merge -output="${PROFILES}/default.profdata" "${PROFILES}"/*.profraw
+fi
+build pgo USE "$@"
+
+for b in release pgo; do
+    echo "== ${b}"
+    "${ROOT}/${b}/ecv-sudoku-bench" "${CORPUS}" "${REPEAT}"
+done
@@ -0,0 +1,540 @@
+/**
+ * @file shard.cpp
+ * @brief Solve a corpus of puzzles with several worker processes
+ * @author lhm
+ *
+ * The coordinator splits the corpus (one puzzle per line, 81 characters, '0' or '.' for an empty
+ * cell) into ranges, and hands them to worker processes connected to a local (unix) socket. The
+ * results are written in the order of the corpus, one line per puzzle : the solution, "invalid"
+ * or "unsolvable".
+ *
+ * A worker that disconnects (i.e crashes) before sending the results of its range has the range
+ * reassigned, and a new local worker is spawned in its place (within a restart budget).
+ *
+ *   ecv-sudoku-shard coordinate <corpus> [-w workers = 4] [-r range = 64] [-s socket] [-o out]
+ *   ecv-sudoku-shard work <socket>
+ *
+ * Workers can also be started by hand (e.g. "-w 0" and several "work" processes). For testing,
+ * ECV_SUDOKU_SHARD_CRASH_AFTER=<n> makes the workers abort after solving n puzzles.
+ *
+ * Protocol (text lines) :
+ *   coordinator -> worker : "RANGE <id> <count>" followed by <count> puzzles, or "DONE"
+ *   worker -> coordinator : "RESULT <id> <count>" followed by <count> results
+ */
+
+// External headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// System headers
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+/*!
+ * \brief The Connection class is a line based, buffered, socket connection
+ */
+class Connection
+{
+public:
+    explicit Connection(int fd) noexcept
+      : _fd{ fd }
+    {}
+
+    ~Connection() noexcept { ::close(_fd); }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    int fd() const noexcept { return _fd; }
+
+    bool send(const std::string& data) noexcept
+    {
+        for (size_t done{ 0 }; done < std::size(data);) {
+            const auto n{ ::send(_fd, data.data() + done, std::size(data) - done, MSG_NOSIGNAL) };
+            if (n < 0 && EINTR == errno)
+                continue;
+            if (n <= 0)
+                return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /*!
+     * \brief fill Read the available data (once)
+     * \return false if the connection is closed
+     */
+    bool fill() noexcept
+    {
+        char buf[4096];
+        auto n{ ::read(_fd, buf, sizeof(buf)) };
+        while (n < 0 && EINTR == errno)
+            n = ::read(_fd, buf, sizeof(buf));
+        if (n <= 0)
+            return false;
+        _buf.append(buf, static_cast<size_t>(n));
+        return true;
+    }
+
+    /*!
+     * \brief line Get the next complete line of the buffer
+     * \return false if there is none
+     */
+    bool line(std::string& out) noexcept
+    {
+        const auto pos{ _buf.find('\n', _pos) };
+        if (std::string::npos == pos)
+            return false;
+
+        out.assign(_buf, _pos, pos - _pos);
+        _pos = pos + 1;
+        if (_pos == std::size(_buf)) {
+            _buf.clear();
+            _pos = 0;
+        }
+        return true;
+    }
+
+    /*!
+     * \brief readLine Blocking read of the next line
+     * \return false if the connection is closed
+     */
+    bool readLine(std::string& out) noexcept
+    {
+        while (!line(out))
+            if (!fill())
+                return false;
+        return true;
+    }
+
+private:
+    const int   _fd;
+    std::string _buf;
+    size_t      _pos{ 0 };
+};
+
+/*****************************************************************************/
+sockaddr_un
+address(const std::string& path) noexcept
+{
+    sockaddr_un ret{};
+    ret.sun_family = AF_UNIX;
+    std::strncpy(ret.sun_path, path.c_str(), sizeof(ret.sun_path) - 1);
+    return ret;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief solve Solve a puzzle using ecv
+ * \return the solution (81 characters), "invalid" or "unsolvable"
+ */
+std::string
+solve(const std::string& puzzle)
+{
+    std::vector<std::string> data(9, std::string(9, '0'));
+    for (size_t k{ 0 }; k < 81 && k < std::size(puzzle); ++k)
+        data[k / 9][k % 9] = ('1' <= puzzle[k] && puzzle[k] <= '9') ? puzzle[k] : '0';
+
+    auto model{ ecv::Sudoku::generate(data) };
+    if (nullptr == model)
+        return "invalid";
+
+    const auto sols{ model->solve(1) };
+    if (std::empty(sols))
+        return "unsolvable";
+
+    std::string ret;
+    for (const auto& row : model->apply(sols.front()))
+        ret += row;
+    return ret;
+}
+
+/*****************************************************************************/
+int
+work(const std::string& path)
+{
+    const int fd{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (fd < 0)
+        return EXIT_FAILURE;
+
+    Connection conn{ fd };
+    const auto addr{ address(path) };
+    if (0 != ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr))) {
+        std::cerr << "Cannot connect to " << path << ": " << std::strerror(errno) << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const char* crash{ std::getenv("ECV_SUDOKU_SHARD_CRASH_AFTER") };
+    long        budget{ nullptr != crash ? std::atol(crash) : -1 };
+
+    for (std::string line; conn.readLine(line) && "DONE" != line;) {
+        std::istringstream header{ line };
+        std::string        cmd;
+        size_t             id{ 0 }, count{ 0 };
+        if (!(header >> cmd >> id >> count) || "RANGE" != cmd)
+            return EXIT_FAILURE;
+
+        std::string reply{ "RESULT " + std::to_string(id) + ' ' + std::to_string(count) + '\n' };
+        for (size_t i{ 0 }; i < count; ++i) {
+            if (!conn.readLine(line))
+                return EXIT_FAILURE;
+            if (0 == budget--)
+                std::abort();
+            reply += solve(line) + '\n';
+        }
+
+        if (!conn.send(reply))
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief The Coordinator class dispatches the ranges of a corpus to the workers
+ */
+class Coordinator
+{
+public:
+    struct Options
+    {
+        size_t      workers{ 4 };
+        size_t      range{ 64 };
+        std::string socket;
+        std::string exe; /*!< Executable of the local workers */
+    };
+
+public:
+    Coordinator(std::vector<std::string> puzzles, Options opts) noexcept
+      : _puzzles{ std::move(puzzles) }
+      , _results(std::size(_puzzles))
+      , _opts{ std::move(opts) }
+    {
+        for (size_t b{ 0 }; b < std::size(_puzzles); b += _opts.range) {
+            _pending.push_back(std::size(_ranges));
+            _ranges.emplace_back(b, std::min(b + _opts.range, std::size(_puzzles)));
+        }
+        _completed.resize(std::size(_ranges), false);
+        _todo = std::size(_ranges);
+    }
+
+    /*!
+     * \brief run Solve the corpus, writing the results in order
+     */
+    bool run(std::ostream& out)
+    {
+        ::unlink(_opts.socket.c_str());
+
+        // The workers are forked from the coordinator : they must not inherit its sockets
+        _listen = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        const auto addr{ address(_opts.socket) };
+        const auto sa{ reinterpret_cast<const sockaddr*>(&addr) };
+        if (_listen < 0 || 0 != ::bind(_listen, sa, sizeof(addr)) ||
+            0 != ::listen(_listen, SOMAXCONN)) {
+            std::cerr << "Cannot listen on " << _opts.socket << ": " << std::strerror(errno)
+                      << '\n';
+            return false;
+        }
+
+        for (size_t i{ 0 }; i < _opts.workers; ++i)
+            spawn();
+
+        const auto ok{ loop(out) };
+
+        // No more workers : the ones still connecting fail (and exit) instead of waiting for work
+        ::close(_listen);
+        ::unlink(_opts.socket.c_str());
+
+        for (auto& [fd, w] : _workers)
+            w.conn->send("DONE\n");
+        _workers.clear();
+        for (auto pid : _children)
+            ::waitpid(pid, nullptr, 0);
+
+        std::cerr << "ranges: " << std::size(_ranges) << " (reassigned: " << _reassigned
+                  << "), workers restarted: " << _restarts << '\n';
+        return ok;
+    }
+
+private:
+    struct Worker
+    {
+        std::unique_ptr<Connection> conn;
+        long                        range{ -1 };     /*!< Range in flight (-1 if idle) */
+        bool                        header{ false }; /*!< Whether its results are being received */
+        std::vector<std::string>    results;         /*!< Results received so far */
+    };
+
+    void spawn() noexcept
+    {
+        if (const auto pid{ ::fork() }; 0 == pid) {
+            ::execl(_opts.exe.c_str(), _opts.exe.c_str(), "work", _opts.socket.c_str(), nullptr);
+            ::_exit(EXIT_FAILURE);
+        } else if (pid > 0) {
+            _children.insert(pid);
+        }
+    }
+
+    /*!
+     * \brief reap Collect the exited local workers, and replace them while there is work left
+     */
+    void reap() noexcept
+    {
+        for (pid_t pid; (pid = ::waitpid(-1, nullptr, WNOHANG)) > 0;) {
+            _children.erase(pid);
+            if (0 != _todo && _restarts < max_restarts * _opts.workers) {
+                ++_restarts;
+                spawn();
+            }
+        }
+    }
+
+    void assign(Worker& w) noexcept
+    {
+        if (std::empty(_pending) || -1 != w.range)
+            return;
+
+        const auto id{ _pending.front() };
+        _pending.pop_front();
+
+        const auto [b, e]{ _ranges[id] };
+        std::string msg{ "RANGE " + std::to_string(id) + ' ' + std::to_string(e - b) + '\n' };
+        for (auto i{ b }; i < e; ++i)
+            msg += _puzzles[i] + '\n';
+
+        w.range = static_cast<long>(id);
+        if (!w.conn->send(msg))
+            drop(w.conn->fd());
+    }
+
+    /*!
+     * \brief drop Forget a worker, reassigning its range if any
+     */
+    void drop(int fd) noexcept
+    {
+        if (auto it{ _workers.find(fd) }; std::end(_workers) != it) {
+            if (-1 != it->second.range) {
+                _pending.push_front(static_cast<size_t>(it->second.range));
+                ++_reassigned;
+            }
+            _workers.erase(it);
+        }
+    }
+
+    /*!
+     * \brief receive Handle the data of a worker
+     * \return false if the worker must be dropped
+     */
+    bool receive(Worker& w) noexcept
+    {
+        if (!w.conn->fill())
+            return false;
+
+        // Nothing is expected from an idle worker
+        if (-1 == w.range)
+            return false;
+
+        const auto  id{ static_cast<size_t>(w.range) };
+        const auto  [b, e]{ _ranges[id] };
+        std::string line;
+
+        if (!w.header) {
+            if (!w.conn->line(line))
+                return true;
+            if (line != "RESULT " + std::to_string(id) + ' ' + std::to_string(e - b))
+                return false;
+            w.header = true;
+        }
+
+        while (std::size(w.results) < e - b && w.conn->line(line))
+            w.results.push_back(line);
+        if (std::size(w.results) < e - b)
+            return true;
+
+        std::move(std::begin(w.results), std::end(w.results), std::begin(_results) + b);
+        w.results.clear();
+        w.header = false;
+        w.range = -1;
+        _completed[id] = true;
+        --_todo;
+
+        return true;
+    }
+
+    /*!
+     * \brief flush Write the results of the completed ranges that follow the written ones
+     */
+    void flush(std::ostream& out)
+    {
+        for (; _written < std::size(_ranges) && _completed[_written]; ++_written) {
+            const auto [b, e]{ _ranges[_written] };
+            for (auto i{ b }; i < e; ++i) {
+                out << _results[i] << '\n';
+                std::string{}.swap(_results[i]);
+            }
+        }
+        out.flush();
+    }
+
+    bool loop(std::ostream& out)
+    {
+        while (0 != _todo) {
+            reap();
+
+            if (std::empty(_workers) && std::empty(_children) && 0 != _opts.workers &&
+                _restarts >= max_restarts * _opts.workers) {
+                std::cerr << "All the workers failed\n";
+                return false;
+            }
+
+            std::vector<pollfd> fds{ { _listen, POLLIN, 0 } };
+            for (const auto& [fd, w] : _workers)
+                fds.push_back({ fd, POLLIN, 0 });
+
+            if (::poll(std::data(fds), std::size(fds), 100) < 0 && EINTR != errno)
+                return false;
+
+            // Accept all the pending workers (the accepted sockets are blocking)
+            if (0 != (fds[0].revents & POLLIN)) {
+                for (int fd; (fd = ::accept4(_listen, nullptr, nullptr, SOCK_CLOEXEC)) >= 0;)
+                    _workers[fd].conn = std::make_unique<Connection>(fd);
+            }
+
+            for (size_t i{ 1 }; i < std::size(fds); ++i) {
+                if (0 == fds[i].revents)
+                    continue;
+                if (!receive(_workers[fds[i].fd]))
+                    drop(fds[i].fd);
+            }
+
+            // A failed assignment drops the worker
+            std::vector<int> idle;
+            for (const auto& [fd, w] : _workers)
+                if (-1 == w.range)
+                    idle.push_back(fd);
+            for (auto fd : idle)
+                assign(_workers[fd]);
+
+            flush(out);
+        }
+
+        flush(out);
+        return true;
+    }
+
+private:
+    static constexpr size_t max_restarts{ 3 }; /*!< Restart budget, per requested worker */
+
+    const std::vector<std::string>         _puzzles;
+    std::vector<std::string>               _results;
+    const Options                          _opts;
+    std::vector<std::pair<size_t, size_t>> _ranges; /*!< [begin, end) of every range */
+    std::vector<bool>                      _completed;
+    std::deque<size_t>                     _pending;
+    std::map<int, Worker>                  _workers;  /*!< Connected workers, by socket */
+    std::set<pid_t>                        _children; /*!< Local workers still running */
+    size_t                                 _todo{ 0 };
+    size_t                                 _written{ 0 }; /*!< Number of ranges written */
+    size_t                                 _reassigned{ 0 }, _restarts{ 0 };
+    int                                    _listen{ -1 };
+};
+
+/*****************************************************************************/
+std::vector<std::string>
+load(const std::string& path)
+{
+    std::vector<std::string> ret;
+    std::ifstream            in{ path };
+
+    for (std::string line; std::getline(in, line);)
+        if (std::size(line) >= 81)
+            ret.push_back(line.substr(0, 81));
+
+    return ret;
+}
+
+/*****************************************************************************/
+int
+usage(const char* exe)
+{
+    std::cerr << "Usage: " << exe
+              << " coordinate <corpus> [-w workers = 4] [-r range = 64] [-s socket] [-o out]\n"
+              << "       " << exe << " work <socket>\n";
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+/*****************************************************************************/
+int
+main(int argc, char* argv[])
+{
+    const std::vector<std::string> args(argv, argv + argc);
+
+    if (3 == argc && "work" == args[1])
+        return work(args[2]);
+
+    if (argc < 3 || "coordinate" != args[1])
+        return usage(argv[0]);
+
+    Coordinator::Options opts;
+    opts.socket = "/tmp/ecv-sudoku-shard-" + std::to_string(::getpid()) + ".sock";
+    opts.exe = "/proc/self/exe";
+    std::string outPath;
+
+    for (size_t i{ 3 }; i + 1 < std::size(args); i += 2) {
+        if ("-w" == args[i])
+            opts.workers = std::strtoul(args[i + 1].c_str(), nullptr, 10);
+        else if ("-r" == args[i])
+            opts.range = std::max(1ul, std::strtoul(args[i + 1].c_str(), nullptr, 10));
+        else if ("-s" == args[i])
+            opts.socket = args[i + 1];
+        else if ("-o" == args[i])
+            outPath = args[i + 1];
+        else
+            return usage(argv[0]);
+    }
+
+    auto puzzles{ load(args[2]) };
+    if (std::empty(puzzles)) {
+        std::cerr << "No puzzle found in " << args[2] << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const auto    start{ std::chrono::steady_clock::now() };
+    std::ofstream file;
+    if (!std::empty(outPath))
+        file.open(outPath);
+
+    Coordinator coordinator{ std::move(puzzles), opts };
+    const auto  ok{ coordinator.run(std::empty(outPath) ? std::cout : file) };
+
+    std::cerr << "total: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+              << " ms\n";
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
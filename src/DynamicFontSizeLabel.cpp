@@ -5,6 +5,9 @@
 #include <QDebug>
 #include <QElapsedTimer>
 
+#include <map>
+#include <tuple>
+
 /*****************************************************************************/
 DynamicFontSizeLabel::DynamicFontSizeLabel(QWidget* parent, Qt::WindowFlags f)
   : QLabel(parent, f)
@@ -16,10 +19,14 @@ DynamicFontSizeLabel::DynamicFontSizeLabel(QWidget* parent, Qt::WindowFlags f)
 void
 DynamicFontSizeLabel::paintEvent(QPaintEvent* event)
 {
-    QFont newFont{ font() };
-    float fontSize{ getWidgetMaximumFontSize(this, this->text()) };
-    newFont.setPointSizeF(fontSize);
-    setFont(newFont);
+    float fontSize{ getCachedMaximumFontSize(this, this->text()) };
+
+    // Avoid setFont when possible, it triggers a polish/layout of the label
+    if (font().pointSizeF() != fontSize) {
+        QFont newFont{ font() };
+        newFont.setPointSizeF(fontSize);
+        setFont(newFont);
+    }
 
     QLabel::paintEvent(event);
 }
@@ -89,6 +96,24 @@ DynamicFontSizeLabel::getWidgetMaximumFontSize(QWidget* widget, QString text)
     return lastTestedSize;
 }
 
+/*****************************************************************************/
+float
+DynamicFontSizeLabel::getCachedMaximumFontSize(QWidget* widget, const QString& text)
+{
+    if (text.isEmpty())
+        return widget->font().pointSizeF();
+
+    static std::map<std::tuple<int, int, QString>, float> cache;
+
+    const QRect rect{ widget->contentsRect() };
+    const auto  key{ std::make_tuple(rect.width(), rect.height(), text) };
+
+    if (auto it{ cache.find(key) }; std::end(cache) != it)
+        return it->second;
+
+    return cache[key] = getWidgetMaximumFontSize(widget, text);
+}
+
 /*****************************************************************************/
 void
 DynamicFontSizeLabel::setTextColor(const QColor& color)
@@ -14,6 +14,13 @@ public:
 
     static float getWidgetMaximumFontSize(QWidget* widget, QString text);
 
+    /*!
+     * \brief getCachedMaximumFontSize Same as getWidgetMaximumFontSize, but the result
+     * is cached by widget geometry and text, so that it is only computed once for all
+     * the labels sharing the same size.
+     */
+    static float getCachedMaximumFontSize(QWidget* widget, const QString& text);
+
     void   setTextColor(const QColor&);
     QColor getTextColor();
 
@@ -0,0 +1,40 @@
+/**
+ * @file bitboard.cpp
+ * @brief Implementation of \a bitboard.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "bitboard.h"
+
+/*****************************************************************************/
+std::vector<std::string>
+BitBoard::toData(const Board& board)
+{
+    auto ret{ std::vector<std::string>(size, std::string(size, '0')) };
+
+    for (size_t k{ 0 }; k < cells; ++k)
+        ret[k / size][k % size] = static_cast<char>('0' + board[k]);
+
+    return ret;
+}
+
+/*****************************************************************************/
+BitBoard::Board
+BitBoard::fromData(const std::vector<std::string>& data) noexcept
+{
+    Board ret{};
+
+    if (size != std::size(data))
+        return ret;
+
+    for (const auto& line : data)
+        if (size != std::size(line))
+            return ret;
+
+    for (size_t k{ 0 }; k < cells; ++k)
+        if (const auto c{ data[k / size][k % size] }; '1' <= c && c <= '9')
+            ret[k] = static_cast<uint8_t>(c - '0');
+
+    return ret;
+}
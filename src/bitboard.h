@@ -0,0 +1,274 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief The BitBoard class is a 9 x 9 sudoku solver keeping the candidates of every row, column
+ * and box as bitmasks, and always branching on the most constrained cell (so that single
+ * candidates are propagated first).
+ *
+ * The most constrained cell is found by scanning the empty cells, stopping at the first one with a
+ * single candidate.
+ *
+ * Everything but the string conversions is constexpr, so that puzzles can be validated and solved
+ * at compile time.
+ */
+class BitBoard
+{
+public:
+    static constexpr size_t size{ 9 };
+    static constexpr size_t cells{ size * size };
+
+    typedef std::array<uint8_t, cells>           Board;  /*!< One value per cell (0 is empty) */
+    typedef std::array<uint8_t, (cells + 1) / 2> Packed; /*!< One nibble per cell */
+
+public:
+    constexpr BitBoard() noexcept
+      : BitBoard(Board{})
+    {}
+
+    /*!
+     * \brief BitBoard Create a solver from a board
+     * \param board the values of the cells (0 is empty)
+     */
+    constexpr explicit BitBoard(const Board& board) noexcept
+    {
+        for (size_t k{ 0 }; k < cells; ++k)
+            insert(_empty, k);
+
+        for (size_t k{ 0 }; k < cells; ++k) {
+            if (0 == board[k])
+                continue;
+            if (board[k] > size || 0 != (used(k) & bit(board[k])))
+                _valid = false;
+            else
+                place(k, board[k]);
+        }
+    }
+
+    /*!
+     * \brief valid Whether the given values are consistent (no duplicate in a row/col/box)
+     */
+    constexpr bool valid() const noexcept { return _valid; }
+
+    /*!
+     * \brief solve Search for the solutions of the board
+     * \param limit the maximum number of solutions to look for
+     * \return the number of solutions found (the first one is available using board())
+     */
+    constexpr size_t solve(size_t limit = 1) noexcept
+    {
+        size_t count{ 0 };
+        Board  first{};
+
+        _nodes = 0;
+        _interrupted = false;
+        if (_valid && 0 != limit)
+            search(limit, count, first);
+        if (0 != count)
+            _board = first;
+
+        return count;
+    }
+
+    constexpr const Board& board() const noexcept { return _board; }
+    constexpr size_t        nodes() const noexcept { return _nodes; }
+
+    /*!
+     * \brief interrupted Whether the last search was stopped (node limit or stop flag)
+     * before being complete
+     */
+    constexpr bool interrupted() const noexcept { return _interrupted; }
+
+    /*!
+     * \brief setStop Set a flag to cooperatively cancel the search (checked every few nodes)
+     */
+    constexpr void setStop(const std::atomic<bool>* stop) noexcept { _stop = stop; }
+
+    /*!
+     * \brief setNodeLimit Set the maximum number of nodes to explore
+     */
+    constexpr void setNodeLimit(size_t limit) noexcept { _nodeLimit = limit; }
+
+    /*!
+     * \brief setSeed Randomize the search (0, the default, keeps it deterministic)
+     */
+    constexpr void setSeed(uint32_t seed) noexcept { _seed = seed; }
+
+
+    /*!
+     * \brief parse Get a board from its 81 characters representation ('1'-'9', others are empty)
+     */
+    static constexpr Board parse(const char* str) noexcept
+    {
+        Board ret{};
+        for (size_t k{ 0 }; k < cells && '\0' != str[k]; ++k)
+            ret[k] = ('1' <= str[k] && str[k] <= '9') ? static_cast<uint8_t>(str[k] - '0') : 0;
+        return ret;
+    }
+
+    static constexpr Packed pack(const Board& board) noexcept
+    {
+        Packed ret{};
+        for (size_t k{ 0 }; k < cells; ++k)
+            ret[k / 2] |= static_cast<uint8_t>((board[k] & 0xF) << (4 * (k % 2)));
+        return ret;
+    }
+
+    static constexpr Board unpack(const Packed& packed) noexcept
+    {
+        Board ret{};
+        for (size_t k{ 0 }; k < cells; ++k)
+            ret[k] = (packed[k / 2] >> (4 * (k % 2))) & 0xF;
+        return ret;
+    }
+
+    /*!
+     * \brief toData Get the Grid representation of a board
+     */
+    static std::vector<std::string> toData(const Board& board);
+
+    /*!
+     * \brief fromData Get a board from the Grid representation (empty board if it is not valid)
+     */
+    static Board fromData(const std::vector<std::string>& data) noexcept;
+
+private:
+    typedef std::array<uint64_t, 2> Cells; /*!< Bitset of cells */
+
+    static constexpr uint16_t bit(size_t v) noexcept { return static_cast<uint16_t>(1u << v); }
+    static constexpr size_t   box(size_t k) noexcept { return (k / 27) * 3 + (k % 9) / 3; }
+
+    static constexpr size_t popcount(uint16_t m) noexcept
+    {
+        return static_cast<size_t>(__builtin_popcount(m));
+    }
+
+    static constexpr void insert(Cells& c, size_t k) noexcept { c[k / 64] |= 1ull << (k % 64); }
+    static constexpr void erase(Cells& c, size_t k) noexcept { c[k / 64] &= ~(1ull << (k % 64)); }
+
+    /*!
+     * \brief lowest Get the first cell of a bitset from a given one (wrapping around)
+     */
+    static constexpr size_t lowest(const Cells& c, size_t from) noexcept
+    {
+        for (size_t w{ from / 64 }; w < std::size(c); ++w)
+            if (const auto bits{ c[w] & (~0ull << (w == from / 64 ? from % 64 : 0)) }; 0 != bits)
+                return w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+
+        return 0 == from ? cells : lowest(c, 0);
+    }
+
+    constexpr uint16_t used(size_t k) const noexcept
+    {
+        return _rows[k / size] | _cols[k % size] | _boxes[box(k)];
+    }
+
+    constexpr uint16_t candidates(size_t k) const noexcept
+    {
+        return static_cast<uint16_t>(~used(k) & 0x3FE);
+    }
+
+    constexpr void place(size_t k, uint8_t v) noexcept
+    {
+        _board[k] = v;
+        erase(_empty, k);
+        _rows[k / size] |= bit(v);
+        _cols[k % size] |= bit(v);
+        _boxes[box(k)] |= bit(v);
+    }
+
+    constexpr void remove(size_t k) noexcept
+    {
+        const auto m{ static_cast<uint16_t>(~bit(_board[k])) };
+        _rows[k / size] &= m;
+        _cols[k % size] &= m;
+        _boxes[box(k)] &= m;
+        _board[k] = 0;
+        insert(_empty, k);
+    }
+
+    /*!
+     * \brief select Get the most constrained empty cell, starting from a given one
+     * \return the cell, cells if there is no empty cell, cells + 1 if a cell has no candidate
+     */
+    constexpr size_t select(size_t offset) const noexcept
+    {
+        // Scans the empty cells only, and stops at the first one with a single candidate
+        Cells  rest{ _empty };
+        size_t best{ cells }, bestCount{ size + 1 };
+        for (auto k{ lowest(rest, offset) }; cells != k && bestCount > 1; k = lowest(rest, k)) {
+            erase(rest, k);
+
+            const auto n{ popcount(candidates(k)) };
+            if (0 == n)
+                return cells + 1;
+            if (n < bestCount) {
+                best = k;
+                bestCount = n;
+            }
+        }
+
+        return best;
+    }
+
+    constexpr uint32_t random() noexcept
+    {
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+        return _seed;
+    }
+
+    constexpr void search(size_t limit, size_t& count, Board& first) noexcept
+    {
+        if (++_nodes > _nodeLimit ||
+            (0 == (_nodes & 0x3FF) && nullptr != _stop && _stop->load(std::memory_order_relaxed))) {
+            _interrupted = true;
+            return;
+        }
+
+        // Most constrained empty cell (from a random cell when randomized)
+        const auto best{ select(0 != _seed ? random() % cells : 0) };
+        if (cells < best)
+            return;
+
+        if (cells == best) {
+            if (0 == count++)
+                first = _board;
+            return;
+        }
+
+        const auto bestMask{ candidates(best) };
+
+        // Values are tried from a random one when randomized
+        const size_t first_v{ 0 != _seed ? random() % size : 0 };
+        for (size_t i{ 0 }; i < size && count < limit && !_interrupted; ++i) {
+            const auto v{ static_cast<uint8_t>((first_v + i) % size + 1) };
+            if (0 == (bestMask & bit(v)))
+                continue;
+            place(best, v);
+            search(limit, count, first);
+            remove(best);
+        }
+    }
+
+private:
+    Board                    _board{};
+    std::array<uint16_t, 9>  _rows{}, _cols{}, _boxes{};
+    Cells                    _empty{}; /*!< Empty cells */
+    size_t                   _nodes{ 0 };
+    size_t                   _nodeLimit{ static_cast<size_t>(-1) };
+    const std::atomic<bool>* _stop{ nullptr };
+    uint32_t                 _seed{ 0 };
+    bool                     _valid{ true };
+    bool                     _interrupted{ false };
+};
+
+#endif // BITBOARD_H
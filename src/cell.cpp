@@ -137,7 +137,7 @@ Cell::updateVal(size_t v) noexcept
     if (_val == v)
         return;
 
-    Op op{ _val, v, this };
+    Op op{ _val, v, _x * _max_val + _y };
 
     _val = v;
     _lb->setText((0 == _val) ? "" : QString::number(_val));
@@ -7,54 +7,77 @@
 // Project's headers
 #include "grid.h"
 #include "cell.h"
+#include "gridview.h"
+#include "trace.h"
 
 // External headers
 #include <ecv.hpp>
 
+// Standard headers
+#include <algorithm>
+
 /*****************************************************************************/
 Grid::Grid(QWidget* parent) noexcept
   : QWidget(parent)
 {
     setFixedSize(500, 500);
 
-    for (size_t i{ 0 }, k{ 0 }; i < _size; ++i)
-        for (size_t j{ 0 }; j < _size; ++j, ++k)
-            _cells[k] = new Cell(i, j, this);
-
-    for (auto& c : _cells) {
-        c->show();
-        connect(c, SIGNAL(changed(Op)), this, SLOT(onCellChanged(Op)));
-        connect(c, &Cell::hovered, this, [c, this](bool hovered) {
-            for (auto cell : _cells) {
-                if (cell == c)
-                    continue;
-                if (cell->_x == c->_x || cell->_y == c->_y ||
-                    ((cell->_x / 3 == c->_x / 3 && cell->_y / 3 == c->_y / 3))) {
-                    if (hovered)
-                        cell->setColorEffect();
-                    else
-                        cell->removeColorEffect();
-                }
-            }
+    if constexpr (painted_renderer) {
+        _cells.fill(nullptr);
+        _view = new GridView(_size, this);
+        _view->setFixedSize(size());
+        connect(_view, &GridView::edited, this, [this](size_t idx, size_t from, size_t to) {
+            onCellChanged(Op{ from, to, idx });
         });
+    } else {
+        for (size_t i{ 0 }, k{ 0 }; i < _size; ++i)
+            for (size_t j{ 0 }; j < _size; ++j, ++k)
+                _cells[k] = new Cell(i, j, this);
+
+        for (auto& c : _cells) {
+            c->show();
+            connect(c, SIGNAL(changed(Op)), this, SLOT(onCellChanged(Op)));
+            connect(c, &Cell::hovered, this, [c, this](bool hovered) {
+                for (auto cell : _cells) {
+                    if (cell == c)
+                        continue;
+                    if (cell->_x == c->_x || cell->_y == c->_y ||
+                        ((cell->_x / 3 == c->_x / 3 && cell->_y / 3 == c->_y / 3))) {
+                        if (hovered)
+                            cell->setColorEffect();
+                        else
+                            cell->removeColorEffect();
+                    }
+                }
+            });
+        }
     }
+
+    resetHist();
 }
 
 /*****************************************************************************/
 bool
 Grid::undo(void) noexcept
 {
-    if (std::empty(_done))
+    if (0 == _pos)
         return false;
 
-    _undone.emplace_back(_done.back());
-    _done.pop_back();
+    _hist[--_pos].reverse().apply(*this);
+
+    emit changed();
+
+    return true;
+}
 
-    if (std::size(_undone) > max_hist_size)
-        _undone.pop_front();
+/*****************************************************************************/
+bool
+Grid::redo(void) noexcept
+{
+    if (std::size(_hist) == _pos)
+        return false;
 
-    const auto op{ _undone.back().reverse() };
-    op.apply();
+    _hist[_pos++].apply(*this);
 
     emit changed();
 
@@ -63,19 +86,27 @@ Grid::undo(void) noexcept
 
 /*****************************************************************************/
 bool
-Grid::redo(void) noexcept
+Grid::jumpTo(size_t pos) noexcept
 {
-    if (std::empty(_undone))
+    if (pos > std::size(_hist) || std::empty(_checkpoints))
         return false;
 
-    _done.emplace_back(_undone.back());
-    _undone.pop_back();
+    if (pos == _pos)
+        return true;
+
+    beginUpdate();
 
-    if (std::size(_done) > max_hist_size)
-        _done.pop_front();
+    // Only walk from the current position when it is closer than the checkpoint
+    const auto chk{ std::min(pos / checkpoint_step, std::size(_checkpoints) - 1) };
+    if (pos < _pos || pos - _pos > pos - chk * checkpoint_step) {
+        restore(_checkpoints[chk]);
+        _pos = chk * checkpoint_step;
+    }
 
-    const auto op{ _done.back() };
-    op.apply();
+    for (; _pos < pos; ++_pos)
+        _hist[_pos].apply(*this);
+
+    endUpdate();
 
     emit changed();
 
@@ -90,7 +121,7 @@ Grid::data() const noexcept
 
     for (size_t i{ 0 }, k{ 0 }; i < _size; ++i)
         for (size_t j{ 0 }; j < _size; ++j, ++k)
-            ret[i][j] = _cells[k]->get() + '0';
+            ret[i][j] = get(k) + '0';
 
     return ret;
 }
@@ -99,6 +130,8 @@ Grid::data() const noexcept
 bool
 Grid::fromData(const std::vector<std::string>& data) noexcept
 {
+    TRACE_SCOPE("Grid::fromData");
+
     if (std::empty(data) || _size != std::size(data))
         return false;
 
@@ -106,12 +139,13 @@ Grid::fromData(const std::vector<std::string>& data) noexcept
         if (_size != std::size(line))
             return false;
 
-    _done.clear();
-    _undone.clear();
-
+    beginUpdate();
     for (size_t i{ 0 }, k{ 0 }; i < _size; ++i)
         for (size_t j{ 0 }; j < _size; ++j, ++k)
-            _cells[k]->set(data[i][j] - '0');
+            set(k, data[i][j] - '0');
+    endUpdate();
+
+    resetHist();
 
     return true;
 }
@@ -120,24 +154,135 @@ Grid::fromData(const std::vector<std::string>& data) noexcept
 void
 Grid::clear(void) noexcept
 {
-    for (auto c : _cells)
-        c->set(0);
+    beginUpdate();
+    for (size_t k{ 0 }; k < _size * _size; ++k)
+        set(k, 0);
+    endUpdate();
 
-    _done.clear();
-    _undone.clear();
+    resetHist();
 
     emit changed();
 }
 
 /*****************************************************************************/
 void
-Grid::onCellChanged(Op op)
+Grid::beginUpdate() noexcept
+{
+    // Disabling the updates of the grid also disables the ones of its cells
+    if (0 == _batch++)
+        setUpdatesEnabled(false);
+}
+
+/*****************************************************************************/
+void
+Grid::endUpdate() noexcept
+{
+    if (0 == _batch || 0 != --_batch)
+        return;
+
+    setUpdatesEnabled(true);
+    update();
+}
+
+/*****************************************************************************/
+Grid::Hist
+Grid::diff(const std::vector<std::string>& from, const std::vector<std::string>& to)
+{
+    Hist ret;
+
+    if (_size != std::size(from) || _size != std::size(to))
+        return ret;
+
+    for (size_t i{ 0 }; i < _size; ++i)
+        if (_size != std::size(from[i]) || _size != std::size(to[i]))
+            return Hist{};
+
+    for (size_t i{ 0 }, k{ 0 }; i < _size; ++i)
+        for (size_t j{ 0 }; j < _size; ++j, ++k)
+            if (from[i][j] != to[i][j])
+                ret.emplace_back(from[i][j] - '0', to[i][j] - '0', k);
+
+    return ret;
+}
+
+/*****************************************************************************/
+void
+Grid::replay(const Hist& path) noexcept
 {
-    _done.push_back(op);
-    _undone.clear();
+    TRACE_SCOPE("Grid::replay");
 
-    if (std::size(_done) > max_hist_size)
-        _done.pop_front();
+    beginUpdate();
+    for (const auto& op : path) {
+        op.apply(*this);
+        push(op);
+    }
+    endUpdate();
+}
+
+/*****************************************************************************/
+void
+Grid::onCellChanged(Op op)
+{
+    push(op);
 
     emit changed();
 }
+
+/*****************************************************************************/
+size_t
+Grid::get(size_t idx) const noexcept
+{
+    return nullptr != _view ? _view->get(idx) : _cells[idx]->get();
+}
+
+/*****************************************************************************/
+void
+Grid::set(size_t idx, size_t val) noexcept
+{
+    if (nullptr != _view)
+        _view->set(idx, val);
+    else
+        _cells[idx]->set(val);
+}
+
+/*****************************************************************************/
+Grid::Snapshot
+Grid::snapshot() const noexcept
+{
+    Snapshot ret{};
+
+    for (size_t k{ 0 }; k < _size * _size; ++k)
+        ret[k / 2] |= static_cast<uint8_t>((get(k) & 0xF) << (4 * (k % 2)));
+
+    return ret;
+}
+
+/*****************************************************************************/
+void
+Grid::restore(const Snapshot& snap) noexcept
+{
+    for (size_t k{ 0 }; k < _size * _size; ++k)
+        set(k, (snap[k / 2] >> (4 * (k % 2))) & 0xF);
+}
+
+/*****************************************************************************/
+void
+Grid::resetHist() noexcept
+{
+    _hist.clear();
+    _pos = 0;
+    _checkpoints.assign(1, snapshot());
+}
+
+/*****************************************************************************/
+void
+Grid::push(Op op) noexcept
+{
+    // A new operation discards the undone ones (and their checkpoints)
+    _hist.resize(_pos);
+    _checkpoints.resize(_pos / checkpoint_step + 1);
+
+    _hist.push_back(op);
+    if (0 == ++_pos % checkpoint_step)
+        _checkpoints.push_back(snapshot());
+}
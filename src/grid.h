@@ -4,11 +4,13 @@
 #include <QWidget>
 
 #include <array>
-#include <stack>
+#include <string>
+#include <vector>
 
 #include "op.h"
 
 class Cell;
+class GridView;
 
 /*!
  * \brief The Grid class exposes a N x N Grid (LatinSquare)
@@ -16,10 +18,35 @@ class Cell;
 class Grid : public QWidget
 {
     Q_OBJECT
+    friend class Op;
+
+    static constexpr size_t _size{ 9 };
+    static_assert(_size <= 15, "The history (Op, Snapshot) packs the values in 4 bits");
 
 public:
-    typedef std::deque<Op>  Hist;
-    static constexpr size_t max_hist_size{ 100 };
+    typedef std::vector<Op> Hist;
+
+    /*!
+     * \brief Snapshot Packed values of the grid (one nibble per cell)
+     */
+    typedef std::array<uint8_t, (_size * _size + 1) / 2> Snapshot;
+
+    /*!
+     * \brief checkpoint_step Number of operations between two snapshots of the history.
+     *
+     * It bounds the number of operations to re-apply when jumping in the history.
+     */
+    static constexpr size_t checkpoint_step{ 64 };
+
+    /*!
+     * \brief painted_renderer Whether the grid is painted by a single GridView
+     * (ECV_SUDOKU_PAINTED_GRID) instead of one Cell widget per cell.
+     */
+#ifdef ECV_SUDOKU_PAINTED_GRID
+    static constexpr bool painted_renderer{ true };
+#else
+    static constexpr bool painted_renderer{ false };
+#endif
 
 public:
     explicit Grid(QWidget* parent = nullptr) noexcept;
@@ -36,6 +63,43 @@ public:
      */
     [[maybe_unused]] bool fromData(const std::vector<std::string>& data) noexcept;
 
+    /*!
+     * \brief beginUpdate Suspend the repaints of the grid until the matching endUpdate.
+     * Calls can be nested, the grid is repainted once when the outermost one ends.
+     */
+    void beginUpdate() noexcept;
+
+    /*!
+     * \brief endUpdate Resume the repaints of the grid (see beginUpdate)
+     */
+    void endUpdate() noexcept;
+
+    /*!
+     * \brief diff Get the operations to go from a grid to another one (one per differing cell, in
+     * row-major order)
+     * \param from the initial grid
+     * \param to the final grid
+     * \return the operations (empty if the grids are not valid)
+     */
+    static Hist diff(const std::vector<std::string>& from, const std::vector<std::string>& to);
+
+    /*!
+     * \brief replay Apply operations (i.e a diff given by Grid::diff) and record them in the
+     * history, so that they can be stepped through using undo/redo/jumpTo.
+     * \param path the operations to apply from the current state
+     */
+    void replay(const Hist& path) noexcept;
+
+    /*!
+     * \brief histSize Get the number of operations in the history
+     */
+    size_t histSize() const noexcept { return std::size(_hist); }
+
+    /*!
+     * \brief histPos Get the current position in the history
+     */
+    size_t histPos() const noexcept { return _pos; }
+
 signals:
     /*!
      * \brief changed emitted when the grid changes
@@ -47,16 +111,32 @@ public slots:
     [[maybe_unused]] bool undo(void) noexcept;
     [[maybe_unused]] bool redo(void) noexcept;
 
+    /*!
+     * \brief jumpTo Go to a given position of the history
+     * \param pos the position (0 is the initial state, histSize() the latest one)
+     */
+    [[maybe_unused]] bool jumpTo(size_t pos) noexcept;
+
     void clear(void) noexcept;
 
 private slots:
     void onCellChanged(Op);
 
 private:
-    static constexpr size_t _size{ 9 };
+    size_t   get(size_t idx) const noexcept;
+    void     set(size_t idx, size_t val) noexcept;
+    Snapshot snapshot() const noexcept;
+    void     restore(const Snapshot&) noexcept;
+    void     resetHist() noexcept;
+    void     push(Op) noexcept;
 
-    std::array<Cell*, _size * _size> _cells;         /*!< Cells of the Grid */
-    Hist                             _done, _undone; /*!< History for undo/redo operations */
+private:
+    std::array<Cell*, _size * _size> _cells;          /*!< Cells of the Grid (Cell renderer) */
+    GridView*                        _view{ nullptr }; /*!< Painted renderer */
+    Hist                             _hist;            /*!< History for undo/redo operations */
+    size_t                           _pos{ 0 };        /*!< Current position in the history */
+    size_t                           _batch{ 0 };      /*!< Nesting level of beginUpdate calls */
+    std::vector<Snapshot>            _checkpoints;     /*!< Grid state every checkpoint_step ops */
 };
 
 #endif // GRID_H
@@ -0,0 +1,256 @@
+/**
+ * @file gridview.cpp
+ * @brief Implementation of \a gridview.h
+ * @author lhm
+ */
+
+#include "gridview.h"
+
+// Project's headers
+#include "trace.h"
+
+// Qt headers
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+
+// Standard headers
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const QColor bgColor{ 0xf1, 0xf2, 0xf3 };
+const QColor peerColor{ 0xf0, 0xa8, 0xa8 };
+const QColor hoverColor{ 0xe3, 0xe4, 0xe5 };
+
+/*!
+ * \brief glyph Text representation of a value (base 36 so that it remains a single character)
+ */
+QString
+glyph(size_t val)
+{
+    return QString::number(static_cast<uint>(val), 36).toUpper();
+}
+
+} // namespace
+
+/*****************************************************************************/
+GridView::GridView(size_t n, QWidget* parent) noexcept
+  : QWidget(parent)
+  , _n{ n }
+  , _box{ static_cast<size_t>(std::lround(std::sqrt(n))) }
+  , _stride{ 2 * (_n - 1) + (_box - 1) * (_box - 1) }
+  , _vals(_n * _n, 0)
+  , _neighbors(_n * _n * _stride)
+  , _peer(_n * _n, 0)
+{
+    setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    // Precompute the neighbors (same row, same column or same box) of every cell
+    for (size_t k{ 0 }; k < _n * _n; ++k) {
+        const auto x{ k / _n }, y{ k % _n };
+        auto       it{ std::begin(_neighbors) + k * _stride };
+
+        for (size_t l{ 0 }; l < _n * _n; ++l) {
+            const auto i{ l / _n }, j{ l % _n };
+            if (l != k && (i == x || j == y || (i / _box == x / _box && j / _box == y / _box)))
+                *it++ = static_cast<uint16_t>(l);
+        }
+    }
+}
+
+/*****************************************************************************/
+void
+GridView::set(size_t idx, size_t val) noexcept
+{
+    if (idx >= std::size(_vals) || val > _n || _vals[idx] == val)
+        return;
+
+    _vals[idx] = static_cast<uint8_t>(val);
+    update(cellRect(idx));
+}
+
+/*****************************************************************************/
+QRect
+GridView::cellRect(size_t idx) const noexcept
+{
+    return QRect(static_cast<int>(idx % _n) * _cellSize,
+                 static_cast<int>(idx / _n) * _cellSize,
+                 _cellSize,
+                 _cellSize);
+}
+
+/*****************************************************************************/
+size_t
+GridView::cellAt(const QPoint& pos) const noexcept
+{
+    if (0 == _cellSize || pos.x() < 0 || pos.y() < 0)
+        return npos;
+
+    const auto i{ static_cast<size_t>(pos.y() / _cellSize) };
+    const auto j{ static_cast<size_t>(pos.x() / _cellSize) };
+
+    return (i < _n && j < _n) ? i * _n + j : npos;
+}
+
+/*****************************************************************************/
+void
+GridView::setHovered(size_t idx) noexcept
+{
+    if (idx == _hovered)
+        return;
+
+    // Only repaint the cells whose highlight changes
+    QRegion dirty;
+    for (auto k : { _hovered, idx }) {
+        if (npos == k)
+            continue;
+
+        const auto on{ static_cast<uint8_t>(k == idx) };
+        for (auto p{ neighbors(k) }, e{ p + _stride }; p != e; ++p) {
+            _peer[*p] = on;
+            dirty += cellRect(*p);
+        }
+        dirty += cellRect(k);
+    }
+
+    _hovered = idx;
+    update(dirty);
+}
+
+/*****************************************************************************/
+void
+GridView::updateGlyphs() noexcept
+{
+    _glyphs.assign(_n + 1, QPixmap());
+    _hoveredGlyphs.assign(_n + 1, QPixmap());
+
+    if (0 == _cellSize)
+        return;
+
+    QFont font{ this->font() };
+    font.setPixelSize(std::max(1, _cellSize * 3 / 5));
+
+    const QRect rect{ 0, 0, _cellSize, _cellSize };
+    const qreal dpr{ devicePixelRatioF() };
+
+    for (size_t v{ 1 }; v <= _n; ++v) {
+        for (auto hovered : { false, true }) {
+            QPixmap pix(rect.size() * dpr);
+            pix.setDevicePixelRatio(dpr);
+            pix.fill(Qt::transparent);
+
+            QPainter p(&pix);
+            p.setRenderHint(QPainter::TextAntialiasing);
+            p.setFont(font);
+
+            if (hovered) {
+                // Cheap glow, drawn once per glyph instead of a QGraphicsEffect per paint
+                QColor glow{ Qt::red };
+                glow.setAlpha(60);
+                p.setPen(glow);
+                for (int dx{ -2 }; dx <= 2; dx += 2)
+                    for (int dy{ -2 }; dy <= 2; dy += 2)
+                        p.drawText(rect.translated(dx, dy), Qt::AlignCenter, glyph(v));
+            }
+
+            p.setPen(Qt::black);
+            p.drawText(rect, Qt::AlignCenter, glyph(v));
+            p.end();
+
+            (hovered ? _hoveredGlyphs : _glyphs)[v] = pix;
+        }
+    }
+}
+
+/*****************************************************************************/
+void
+GridView::paintEvent(QPaintEvent* e)
+{
+    TRACE_SCOPE("GridView::paintEvent");
+
+    QPainter p(this);
+    p.fillRect(e->rect(), palette().window());
+
+    const int side{ static_cast<int>(_n) * _cellSize };
+    const int radius{ _cellSize / 5 };
+
+    // Rounded outer corners, as the Cell based rendering does
+    QPainterPath outline;
+    outline.addRoundedRect(QRectF(0.5, 0.5, side - 1, side - 1), radius, radius);
+    p.setClipPath(outline);
+
+    for (size_t k{ 0 }; k < _n * _n; ++k) {
+        const auto rect{ cellRect(k) };
+        if (!e->rect().intersects(rect))
+            continue;
+
+        p.fillRect(rect, k == _hovered ? hoverColor : (_peer[k] ? peerColor : bgColor));
+        if (0 != _vals[k])
+            p.drawPixmap(rect.topLeft(), (k == _hovered ? _hoveredGlyphs : _glyphs)[_vals[k]]);
+    }
+
+    // Grid lines (thicker between boxes)
+    for (size_t l{ 1 }; l < _n; ++l) {
+        const int pos{ static_cast<int>(l) * _cellSize };
+        p.setPen(QPen(Qt::black, 0 == l % _box ? 3 : 1));
+        p.drawLine(pos, 0, pos, side);
+        p.drawLine(0, pos, side, pos);
+    }
+
+    p.setClipping(false);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(QPen(Qt::black, 1));
+    p.drawPath(outline);
+}
+
+/*****************************************************************************/
+void
+GridView::resizeEvent(QResizeEvent* e)
+{
+    if (const int cellSize{ std::min(width(), height()) / static_cast<int>(_n) };
+        cellSize != _cellSize) {
+        _cellSize = cellSize;
+        updateGlyphs();
+    }
+
+    QWidget::resizeEvent(e);
+}
+
+/*****************************************************************************/
+void
+GridView::mouseMoveEvent(QMouseEvent* e)
+{
+    setFocus(Qt::FocusReason::OtherFocusReason);
+    setHovered(cellAt(e->pos()));
+
+    QWidget::mouseMoveEvent(e);
+}
+
+/*****************************************************************************/
+void
+GridView::leaveEvent(QEvent* e)
+{
+    setHovered(npos);
+
+    QWidget::leaveEvent(e);
+}
+
+/*****************************************************************************/
+void
+GridView::keyReleaseEvent(QKeyEvent* e)
+{
+    auto ok{ false };
+
+    if (auto val{ e->text().toUInt(&ok, 36) }; ok && npos != _hovered && val <= _n) {
+        if (const size_t from{ _vals[_hovered] }; from != val) {
+            set(_hovered, val);
+            emit edited(_hovered, from, val);
+        }
+    }
+    QWidget::keyReleaseEvent(e);
+}
@@ -0,0 +1,75 @@
+#ifndef GRIDVIEW_H
+#define GRIDVIEW_H
+
+#include <QPixmap>
+#include <QWidget>
+
+#include <cstdint>
+#include <vector>
+
+/*!
+ * \brief The GridView class renders a N x N Grid (N being a square) in a single widget.
+ *
+ * Only the 9 x 9 Grid is supported : its history (Op, Grid::Snapshot) packs the values in 4 bits.
+ *
+ * Unlike the Cell based rendering, all the cells are painted in one paintEvent using cached glyph
+ * pixmaps, and the neighbors of each cell are precomputed so that hovering a cell only repaints
+ * the cells whose highlight actually changed.
+ */
+class GridView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr size_t npos{ static_cast<size_t>(-1) };
+
+public:
+    explicit GridView(size_t n = 9, QWidget* parent = nullptr) noexcept;
+    virtual ~GridView() noexcept = default;
+
+    size_t n() const noexcept { return _n; }
+
+    void   set(size_t idx, size_t val) noexcept;
+    size_t get(size_t idx) const noexcept { return _vals[idx]; }
+
+    /*!
+     * \brief neighbors Get the cells sharing a row, a column or a box with a cell
+     * \param idx the index of the cell
+     * \return pointer on the first neighbor (there are neighborsCount() of them)
+     */
+    const uint16_t* neighbors(size_t idx) const noexcept { return &_neighbors[idx * _stride]; }
+    size_t          neighborsCount() const noexcept { return _stride; }
+
+signals:
+    /*!
+     * \brief edited emitted when the user changes the value of a cell
+     */
+    void edited(size_t idx, size_t from, size_t to);
+
+protected:
+    void paintEvent(QPaintEvent*) override;
+    void resizeEvent(QResizeEvent*) override;
+    void mouseMoveEvent(QMouseEvent*) override;
+    void leaveEvent(QEvent*) override;
+    void keyReleaseEvent(QKeyEvent*) override;
+
+private:
+    QRect  cellRect(size_t idx) const noexcept;
+    size_t cellAt(const QPoint&) const noexcept;
+    void   setHovered(size_t idx) noexcept;
+    void   updateGlyphs() noexcept;
+
+private:
+    const size_t _n, _box, _stride;
+
+    std::vector<uint8_t>  _vals;      /*!< Values of the cells (0 is empty) */
+    std::vector<uint16_t> _neighbors; /*!< _stride neighbors for each cell */
+    std::vector<uint8_t>  _peer;      /*!< Whether each cell is a neighbor of the hovered one */
+    size_t                _hovered{ npos };
+
+    // Glyphs of the values (index 0 unused), plain and highlighted, for the current cell size
+    std::vector<QPixmap> _glyphs, _hoveredGlyphs;
+    int                  _cellSize{ 0 };
+};
+
+#endif // GRIDVIEW_H
@@ -6,7 +6,10 @@ int
 main(int argc, char* argv[])
 {
     QApplication app(argc, argv);
-    MainWindow   window;
+    QApplication::setOrganizationName("ecv");
+    QApplication::setApplicationName("ecv-sudoku");
+
+    MainWindow window;
 
     window.show();
 
@@ -7,20 +7,27 @@
 // Project's headers
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
+#include "portfolio.h"
+#include "puzzlequeue.h"
+#include "puzzles.h"
+#include "solutionstore.h"
+#include "trace.h"
 
 // External headers
 #include <ecv.hpp>
 
 // Standard headers
+#include <algorithm>
 #include <chrono>
 #include <random>
 
 // Qt headers
 #include <QGraphicsDropShadowEffect>
 #include <QIntValidator>
+#include <QSettings>
+#include <QShortcut>
 
-static auto                         _sols{ ecv::Sudoku::generate()->solve(1) };
-static std::unique_ptr<ecv::Sudoku> _model{ nullptr };
+static SolutionStore _sols;
 
 /*****************************************************************************/
 void
@@ -35,6 +42,39 @@ setupWidget(QWidget* w, const QString& name = "setupWidget")
     w->setGraphicsEffect(shadow_effect);
 }
 
+/*****************************************************************************/
+void
+repaintTraced(QWidget* w)
+{
+    TRACE_SCOPE("repaint");
+    w->repaint();
+}
+
+/*****************************************************************************/
+/*!
+ * @brief Record the win of a portfolio engine in the settings (kept across sessions, so that
+ * the engines can be tuned from actual usage)
+ * @return the wins of every engine so far
+ */
+QString
+recordWin(Portfolio::Engine winner)
+{
+    QSettings   settings;
+    QStringList ret;
+
+    for (size_t e{ 0 }; e < Portfolio::EnginesCount; ++e) {
+        const auto engine{ static_cast<Portfolio::Engine>(e) };
+        const auto key{ QString("portfolio/wins/%1").arg(Portfolio::name(engine)) };
+        auto       wins{ settings.value(key, 0).toULongLong() };
+
+        if (engine == winner)
+            settings.setValue(key, ++wins);
+        ret << QString("%1: %2").arg(Portfolio::name(engine)).arg(wins);
+    }
+
+    return "Wins - " + ret.join(" - ");
+}
+
 /*****************************************************************************/
 /*!
  * @brief Very basic stopwatch to measure ellapsed time since it has been created
@@ -92,10 +132,15 @@ private:
 MainWindow::MainWindow(QWidget* parent)
   : QMainWindow(parent)
   , ui(new Ui::MainWindow)
+  , _puzzles(new PuzzleQueue)
+  , _portfolio(new Portfolio)
 {
     ui->setupUi(this);
     ui->res_gb->setEnabled(false);
 
+    // Start with the puzzle of the day (validated and solved at compile time)
+    ui->square_w->fromData(BitBoard::toData(BitBoard::unpack(dailyPuzzle().puzzle)));
+
     ui->le_sols->setValidator(new QIntValidator(1, 1000000, this));
     new CLineEdit(ui->le_sols);
 
@@ -129,6 +174,7 @@ MainWindow::MainWindow(QWidget* parent)
         if (ui->res_gb->isEnabled()) {
             ui->res_gb->setDisabled(true);
             ui->res_label->clear();
+            ui->res_label->setToolTip({});
         }
     });
 
@@ -136,8 +182,23 @@ MainWindow::MainWindow(QWidget* parent)
     connect(ui->undo_cb, SIGNAL(clicked()), ui->square_w, SLOT(undo()));
     connect(ui->redo_cb, SIGNAL(clicked()), ui->square_w, SLOT(redo()));
     connect(ui->new_pb, &QPushButton::clicked, this, [this]() { ui->square_w->clear(); });
+
+    // Jump through the history : to its ends, or by checkpoints (cheapest jumps)
+    const auto jump{ [this](const QKeySequence& key, auto pos) {
+        connect(new QShortcut(key, this), &QShortcut::activated, this, [this, pos]() {
+            ui->square_w->jumpTo(pos(ui->square_w->histPos(), ui->square_w->histSize()));
+        });
+    } };
+    jump(Qt::CTRL + Qt::Key_Home, [](size_t, size_t) -> size_t { return 0; });
+    jump(Qt::CTRL + Qt::Key_End, [](size_t, size_t size) { return size; });
+    jump(Qt::Key_PageUp, [](size_t pos, size_t) {
+        return pos - std::min(pos, Grid::checkpoint_step);
+    });
+    jump(Qt::Key_PageDown, [](size_t pos, size_t size) {
+        return std::min(size, pos + Grid::checkpoint_step);
+    });
     connect(ui->res_pb, &QPushButton::clicked, this, [this]() {
-        if (nullptr == _model || std::empty(_sols))
+        if (std::size(_sols) < 2)
             return;
 
         static std::random_device dev;
@@ -146,81 +207,156 @@ MainWindow::MainWindow(QWidget* parent)
         std::uniform_int_distribution<std::mt19937::result_type> dist{ 1, std::size(_sols) - 1 };
 
         ui->centralwidget->setDisabled(true);
-        ui->centralwidget->repaint();
+        repaintTraced(ui->centralwidget);
 
-        ui->square_w->fromData(_model->apply(_sols[dist(rng)]));
+        ui->square_w->fromData(BitBoard::toData(_sols.at(dist(rng))));
 
         ui->centralwidget->setDisabled(false);
-        ui->centralwidget->repaint();
+        repaintTraced(ui->centralwidget);
     });
     connect(ui->solve_pb, &QPushButton::clicked, this, [this]() {
         ui->centralwidget->setGraphicsEffect(new QGraphicsBlurEffect);
         ui->centralwidget->setDisabled(true);
-        ui->centralwidget->repaint();
+        repaintTraced(ui->centralwidget);
 
-        // Perform the ecv resolution
         _sols.clear();
-        _model.reset(nullptr);
-        _model = ecv::Sudoku::generate(ui->square_w->data());
-        if (nullptr == _model)
+
+        // A puzzle of the library : its unique solution is embedded, no need to search it
+        const auto board{ BitBoard::fromData(ui->square_w->data()) };
+        if (const auto known{ findPuzzle(board) }; nullptr != known) {
+            const auto solution{ BitBoard::unpack(known->solution) };
+            _sols.reset(board);
+            _sols.push(solution);
+
+            ui->res_pb->setEnabled(false);
+            ui->res_gb->setEnabled(true);
+            ui->res_label->setText("Found 1 solution (embedded)");
+            ui->square_w->replay(Grid::diff(ui->square_w->data(), BitBoard::toData(solution)));
+
+            ui->centralwidget->setGraphicsEffect(nullptr);
+            ui->centralwidget->setDisabled(false);
+            repaintTraced(ui->centralwidget);
+            return;
+        }
+
+        // A single solution is asked : race the engines and keep the first answer
+        if (1 == ui->le_sols->text().toULong()) {
+            TRACE_SCOPE("portfolio");
+            const auto res{ _portfolio->solve(board) };
+
+            if (res.solved) {
+                ui->res_pb->setEnabled(false);
+                ui->res_gb->setEnabled(true);
+                ui->res_label->setText(QString("Found 1 solution (%1 ms, %2)")
+                                         .arg(res.elapsed.count() / 1000.0, 0, 'f', 1)
+                                         .arg(Portfolio::name(res.engine)));
+                ui->res_label->setToolTip(recordWin(res.engine));
+                ui->square_w->replay(
+                  Grid::diff(ui->square_w->data(), BitBoard::toData(res.solution)));
+            } else {
+                ui->res_label->setText("No solution");
+            }
+
+            ui->centralwidget->setGraphicsEffect(nullptr);
+            ui->centralwidget->setDisabled(false);
+            repaintTraced(ui->centralwidget);
+            return;
+        }
+
+        // Perform the ecv resolution
+        decltype(ecv::Sudoku::generate()) model;
+        {
+            TRACE_SCOPE("generate");
+            model = ecv::Sudoku::generate(ui->square_w->data());
+        }
+        if (nullptr == model)
             return;
 
         stopwatch watch;
-        _sols = _model->solve(ui->le_sols->text().toULong());
+        auto      solving{ watch.elapsed() };
+        {
+            // ecv only returns all the solutions at once : the peak memory is the ecv one, the
+            // store only bounds the memory kept afterwards
+            auto sols{ [&model, this]() {
+                TRACE_SCOPE("solve");
+                return model->solve(ui->le_sols->text().toULong());
+            }() };
+            solving = watch.elapsed();
+
+            // Compress the solutions, releasing the ecv ones as they are converted
+            TRACE_SCOPE("compress");
+            _sols.reset(board);
+            _sols.reserve(std::size(sols));
+            for (auto& sol : sols) {
+                _sols.push(BitBoard::fromData(model->apply(sol)));
+                decltype(sols)::value_type{}.swap(sol);
+            }
+        }
+        const auto elapsed{ watch.elapsed() };
 
         if (auto solsNb{ std::size(_sols) }; solsNb > 0) {
             ui->res_pb->setEnabled(solsNb > 1);
             ui->res_gb->setEnabled(true);
-            ui->res_label->setText(QString("Found %1 solutions (%2 ms)")
-                                     .arg(std::size(_sols))
-                                     .arg(watch.elapsed().count()));
-            ui->square_w->fromData(_model->apply(_sols[0]));
+            ui->res_label->setText(QString("Found %1 solutions (%2 ms, %3 ms to compress, %4 MB)")
+                                     .arg(solsNb)
+                                     .arg(elapsed.count())
+                                     .arg((elapsed - solving).count())
+                                     .arg(_sols.memory() / (1024.0 * 1024.0), 0, 'f', 1));
+            // Record the puzzle -> solution diff, so that it can be stepped through with undo/redo
+            auto path{ Grid::diff(ui->square_w->data(), BitBoard::toData(_sols.at(0))) };
+            ui->square_w->replay(path);
         } else {
             ui->res_label->setText("No solution");
         }
 
         ui->centralwidget->setGraphicsEffect(nullptr);
         ui->centralwidget->setDisabled(false);
-        ui->centralwidget->repaint();
+        repaintTraced(ui->centralwidget);
     });
-    connect(ui->pb_random, &QPushButton::clicked, this, [this]() {
-        ui->centralwidget->setGraphicsEffect(new QGraphicsBlurEffect);
-        ui->centralwidget->setDisabled(true);
-        ui->centralwidget->repaint();
 
-        _model.reset(nullptr);
+    // Random puzzles are served from the background queue, kept filled for the current clue count
+    _puzzles->request(ui->le_nbcells->text().toUInt());
+    connect(ui->le_nbcells, &QLineEdit::textChanged, this, [this](const QString& txt) {
+        if (!txt.isEmpty())
+            _puzzles->request(txt.toUInt());
+    });
+    connect(ui->pb_random, &QPushButton::clicked, this, [this]() {
         _sols.clear();
 
-        _model = ecv::Sudoku::generate();
-        _sols = _model->solve(10000);
+        const auto clues{ std::min(81u, ui->le_nbcells->text().toUInt()) };
 
-        static std::random_device dev;
-        static std::mt19937       rng{ dev() };
+        // Only happens if the producer has not caught up yet
+        const auto wait{ 0 == _puzzles->metrics(clues).depth };
+        if (wait) {
+            ui->centralwidget->setGraphicsEffect(new QGraphicsBlurEffect);
+            ui->centralwidget->setDisabled(true);
+            repaintTraced(ui->centralwidget);
+        }
 
-        std::uniform_int_distribution<std::mt19937::result_type> dist{ 1, std::size(_sols) - 1 };
-        static std::uniform_int_distribution<std::mt19937::result_type> idxes{ 0, 8 };
+        ui->square_w->fromData(BitBoard::toData(_puzzles->take(clues)));
 
-        ui->centralwidget->setDisabled(true);
-        ui->centralwidget->repaint();
-
-        auto st{ _model->apply(_sols[dist(rng)]) };
-        auto cmpt{ 0 };
-        while (cmpt < (81 - std::min(81, ui->le_nbcells->text().toInt()))) {
-            if (auto& c{ st[idxes(rng)][idxes(rng)] }; '0' != c) {
-                c = '0';
-                ++cmpt;
-            }
+        if (wait) {
+            ui->centralwidget->setGraphicsEffect(nullptr);
+            ui->centralwidget->setDisabled(false);
+            repaintTraced(ui->centralwidget);
         }
-        ui->square_w->fromData(st);
 
-        ui->centralwidget->setGraphicsEffect(nullptr);
-        ui->centralwidget->setDisabled(false);
-        ui->centralwidget->repaint();
+        const auto metrics{ _puzzles->metrics(clues) };
+        ui->pb_random->setToolTip(
+          QString("Ready: %1 - Produced: %2 (%3/s) - Served: %4 - Waits: %5 - Pool: %6 ms")
+            .arg(metrics.depth)
+            .arg(metrics.produced)
+            .arg(metrics.refillRate, 0, 'f', 0)
+            .arg(metrics.served)
+            .arg(metrics.misses)
+            .arg(metrics.poolMs, 0, 'f', 0));
     });
 }
 
 /*****************************************************************************/
 MainWindow::~MainWindow()
 {
+    delete _portfolio;
+    delete _puzzles;
     delete ui;
 }
@@ -9,6 +9,9 @@ class MainWindow;
 }
 QT_END_NAMESPACE
 
+class Portfolio;
+class PuzzleQueue;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -19,5 +22,7 @@ public:
 
 private:
     Ui::MainWindow* ui;
+    PuzzleQueue*    _puzzles;   /*!< Ready-made random puzzles */
+    Portfolio*      _portfolio; /*!< Engines raced to find a single solution */
 };
 #endif // MAINWINDOW_H
@@ -1,35 +1,16 @@
 /**
- * @file grid.cpp
- * @brief Implementation of \a grid.h
+ * @file op.cpp
+ * @brief Implementation of \a op.h
  * @author lhm
  */
 
 // Project's headers
 #include "op.h"
-#include "cell.h"
-
-/*****************************************************************************/
-Op::Op(size_t from, size_t to, Cell* cell) noexcept
-  : from{ from }
-  , to{ to }
-  , cell{ cell }
-{}
-
-/*****************************************************************************/
-Op
-Op::reverse() noexcept
-{
-    Op ret;
-    ret.cell = cell;
-    ret.from = to;
-    ret.to = from;
-    return ret;
-}
+#include "grid.h"
 
 /*****************************************************************************/
 void
-Op::apply() const noexcept
+Op::apply(Grid& grid) const noexcept
 {
-    if (nullptr != cell)
-        cell->set(to);
+    grid.set(idx(), to());
 }
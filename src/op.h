@@ -2,25 +2,40 @@
 #define OP_H
 
 #include <cstddef>
+#include <cstdint>
 
-class Cell;
+class Grid;
 
+/*!
+ * \brief The Op class is a single cell modification, packed in 2 bytes
+ *
+ * Layout : [ cell index (8 bits) | from (4 bits) | to (4 bits) ]
+ */
 class Op
 {
 public:
-    Op(size_t from = 0, size_t to = 0, Cell* cell = nullptr) noexcept;
+    constexpr Op(size_t from = 0, size_t to = 0, size_t idx = 0) noexcept
+      : _bits{ static_cast<uint16_t>(((idx & 0xFF) << 8) | ((from & 0xF) << 4) | (to & 0xF)) }
+    {}
 
     /*!
      * \brief reverse Create a reverse operation
-     * \param op
      */
-    Op reverse() noexcept;
+    constexpr Op reverse() const noexcept { return Op(to(), from(), idx()); }
 
-    void apply() const noexcept;
+    constexpr size_t from() const noexcept { return (_bits >> 4) & 0xF; }
+    constexpr size_t to() const noexcept { return _bits & 0xF; }
+    constexpr size_t idx() const noexcept { return _bits >> 8; }
+
+    /*!
+     * \brief apply Apply the operation on the targeted cell of a grid
+     */
+    void apply(Grid& grid) const noexcept;
 
 private:
-    size_t from, to; /*< Previous value (before operation) and after */
-    Cell*  cell;
+    uint16_t _bits;
 };
 
+static_assert(sizeof(Op) == 2, "Op is expected to be packed in 2 bytes");
+
 #endif // OP_H
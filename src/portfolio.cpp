@@ -0,0 +1,201 @@
+/**
+ * @file portfolio.cpp
+ * @brief Implementation of \a portfolio.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "portfolio.h"
+#include "trace.h"
+
+// External headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <vector>
+
+/*!
+ * \brief The Race struct is the state shared by the engines of a race. It is shared so that an
+ * engine that cannot be interrupted may outlive the call to solve.
+ */
+struct Portfolio::Race
+{
+    std::atomic<bool>              stop{ false };
+    std::mutex                     mutex;
+    std::condition_variable        cv;
+    size_t                         engines{ 0 }; /*!< Number of engines taking part */
+    size_t                         finished{ 0 };
+    std::array<bool, EnginesCount> done{};
+    Result                         result;
+
+    /*!
+     * \brief finish Report the outcome of an engine (the first solution wins)
+     */
+    void finish(Engine engine, bool solved, const BitBoard::Board& solution) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            ++finished;
+            done[engine] = true;
+            if (solved && !result.solved) {
+                result.solved = true;
+                result.engine = engine;
+                result.solution = solution;
+                stop = true;
+            }
+        }
+        cv.notify_all();
+    }
+};
+
+/*****************************************************************************/
+void
+Portfolio::algorithmX(const BitBoard::Board& puzzle, Race& race) noexcept
+{
+    TRACE_SCOPE("algorithm X");
+
+    BitBoard::Board ret{};
+    auto            solved{ false };
+
+    if (auto model{ ecv::Sudoku::generate(BitBoard::toData(puzzle)) }; nullptr != model) {
+        if (const auto sols{ model->solve(1) }; !std::empty(sols)) {
+            ret = BitBoard::fromData(model->apply(sols.front()));
+            solved = true;
+        }
+    }
+
+    race.finish(AlgorithmX, solved, ret);
+}
+
+/*****************************************************************************/
+void
+Portfolio::propagation(const BitBoard::Board& puzzle, Race& race) noexcept
+{
+    TRACE_SCOPE("propagation");
+
+    BitBoard solver{ puzzle };
+    solver.setStop(&race.stop);
+
+    const auto solved{ 1 == solver.solve(1) };
+    race.finish(Propagation, solved, solver.board());
+}
+
+/*****************************************************************************/
+void
+Portfolio::randomRestart(const BitBoard::Board& puzzle, Race& race) noexcept
+{
+    TRACE_SCOPE("random restart");
+
+    std::mt19937 rng{ std::random_device{}() };
+
+    for (auto limit{ first_restart_nodes }; !race.stop; limit *= 2) {
+        BitBoard solver{ puzzle };
+        solver.setStop(&race.stop);
+        solver.setNodeLimit(limit);
+        solver.setSeed(rng() | 1);
+
+        // Either solved or proven unsolvable (complete search), otherwise restart with more nodes
+        if (const auto solved{ 1 == solver.solve(1) }; solved || !solver.interrupted()) {
+            race.finish(RandomRestart, solved, solver.board());
+            return;
+        }
+    }
+
+    race.finish(RandomRestart, false, BitBoard::Board{});
+}
+
+/*****************************************************************************/
+Portfolio::~Portfolio() noexcept
+{
+    if (_algorithmX.joinable())
+        _algorithmX.join();
+}
+
+/*****************************************************************************/
+const char*
+Portfolio::name(Engine engine) noexcept
+{
+    switch (engine) {
+        case AlgorithmX:
+            return "algorithm X";
+        case Propagation:
+            return "propagation";
+        case RandomRestart:
+            return "random restart";
+        default:
+            return "none";
+    }
+}
+
+/*****************************************************************************/
+Portfolio::Result
+Portfolio::solve(const BitBoard::Board& puzzle) noexcept
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    auto       race{ std::make_shared<Race>() };
+
+    // The ecv search of a previous race may still be running : this one goes without it
+    if (algorithmXAvailable()) {
+        race->engines = 1;
+        _algorithmX = std::thread{ [puzzle, race]() { algorithmX(puzzle, *race); } };
+        _algorithmXRace = race;
+    }
+
+    std::vector<std::thread> threads;
+    race->engines += 2;
+    for (auto engine : { propagation, randomRestart })
+        threads.emplace_back([engine, puzzle, race]() { engine(puzzle, *race); });
+
+    Result ret;
+    {
+        std::unique_lock<std::mutex> lock{ race->mutex };
+        race->cv.wait(lock, [&race]() {
+            return race->result.solved || race->engines == race->finished;
+        });
+
+        race->stop = true;
+        ret = race->result;
+    }
+
+    // The BitBoard engines stop within a few nodes
+    for (auto& t : threads)
+        t.join();
+
+    ret.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+    if (ret.solved)
+        ++_wins[ret.engine];
+
+    return ret;
+}
+
+/*****************************************************************************/
+std::array<size_t, Portfolio::EnginesCount>
+Portfolio::wins() const noexcept
+{
+    std::array<size_t, EnginesCount> ret;
+    for (size_t e{ 0 }; e < EnginesCount; ++e)
+        ret[e] = _wins[e];
+    return ret;
+}
+
+/*****************************************************************************/
+bool
+Portfolio::algorithmXAvailable() noexcept
+{
+    if (!_algorithmX.joinable())
+        return true;
+
+    {
+        std::lock_guard<std::mutex> lock{ _algorithmXRace->mutex };
+        if (!_algorithmXRace->done[AlgorithmX])
+            return false;
+    }
+
+    _algorithmX.join();
+    _algorithmXRace.reset();
+    return true;
+}
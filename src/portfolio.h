@@ -0,0 +1,82 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "bitboard.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+/*!
+ * \brief The Portfolio class races several solving engines on the same puzzle and keeps the first
+ * answer.
+ *
+ * The losers are cancelled cooperatively. The BitBoard based engines stop within a few nodes and
+ * are joined before solve returns, but the ecv search cannot be interrupted : its thread is left
+ * to complete in the background, and the races started meanwhile go without it. It is only joined
+ * once it is done (or on destruction).
+ */
+class Portfolio
+{
+public:
+    enum Engine : size_t
+    {
+        AlgorithmX,    /*!< ecv::Sudoku (Knuth's Algorithm X) */
+        Propagation,   /*!< BitBoard, most constrained cell first */
+        RandomRestart, /*!< Randomized BitBoard with a growing node limit between restarts */
+        EnginesCount
+    };
+
+    static constexpr size_t first_restart_nodes{ 1000 }; /*!< Node limit of the first restart */
+
+    struct Result
+    {
+        bool                      solved{ false };
+        Engine                    engine{ EnginesCount }; /*!< Winner (EnginesCount if none) */
+        BitBoard::Board           solution{};
+        std::chrono::microseconds elapsed{ 0 };
+    };
+
+public:
+    Portfolio() noexcept = default;
+    ~Portfolio() noexcept;
+
+    Portfolio(const Portfolio&) = delete;
+    Portfolio& operator=(const Portfolio&) = delete;
+
+    static const char* name(Engine) noexcept;
+
+    /*!
+     * \brief solve Race the engines on a puzzle
+     * \param puzzle the puzzle
+     * \return the first solution found (solved is false if no engine found one)
+     */
+    Result solve(const BitBoard::Board& puzzle) noexcept;
+
+    /*!
+     * \brief wins Get the number of races won by each engine
+     */
+    std::array<size_t, EnginesCount> wins() const noexcept;
+
+private:
+    struct Race;
+
+    static void algorithmX(const BitBoard::Board& puzzle, Race& race) noexcept;
+    static void propagation(const BitBoard::Board& puzzle, Race& race) noexcept;
+    static void randomRestart(const BitBoard::Board& puzzle, Race& race) noexcept;
+
+    /*!
+     * \brief algorithmXAvailable Whether a new ecv search can be started (joining the previous one
+     * if it is done)
+     */
+    bool algorithmXAvailable() noexcept;
+
+private:
+    std::thread                                   _algorithmX;     /*!< Last ecv search */
+    std::shared_ptr<Race>                         _algorithmXRace; /*!< Its race */
+    std::array<std::atomic<size_t>, EnginesCount> _wins{};
+};
+
+#endif // PORTFOLIO_H
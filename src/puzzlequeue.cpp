@@ -0,0 +1,167 @@
+/**
+ * @file puzzlequeue.cpp
+ * @brief Implementation of \a puzzlequeue.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "puzzlequeue.h"
+#include "trace.h"
+
+// External headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/*****************************************************************************/
+PuzzleQueue::PuzzleQueue() noexcept
+  : _producer{ &PuzzleQueue::produce, this }
+{}
+
+/*****************************************************************************/
+PuzzleQueue::~PuzzleQueue() noexcept
+{
+    _stop = true;
+    notify();
+    _producer.join();
+}
+
+/*****************************************************************************/
+void
+PuzzleQueue::request(size_t clues) noexcept
+{
+    clues = std::min(clues, BitBoard::cells);
+    if (!_requested[clues].exchange(true))
+        notify();
+}
+
+/*****************************************************************************/
+BitBoard::Board
+PuzzleQueue::take(size_t clues) noexcept
+{
+    clues = std::min(clues, BitBoard::cells);
+
+    BitBoard::Packed ret;
+    auto&            ring{ _rings[clues] };
+
+    if (!ring.pop(ret)) {
+        ++_misses;
+        request(clues);
+
+        auto                         ok{ false };
+        std::unique_lock<std::mutex> lock{ _mutex };
+        _cv.wait(lock, [this, &ring, &ret, &ok]() { return (ok = ring.pop(ret)) || _stop; });
+
+        if (!ok)
+            return BitBoard::Board{};
+    }
+
+    ++_served;
+    notify();
+
+    return BitBoard::unpack(ret);
+}
+
+/*****************************************************************************/
+PuzzleQueue::Metrics
+PuzzleQueue::metrics(size_t clues) const noexcept
+{
+    const auto produced{ _produced.load() };
+    const auto busy{ _busy_us.load() };
+
+    return Metrics{ _rings[std::min(clues, BitBoard::cells)].size(),
+                    produced,
+                    _served.load(),
+                    _misses.load(),
+                    0 == busy ? 0.0 : produced * 1e6 / busy,
+                    _pool_us.load() / 1000.0 };
+}
+
+/*****************************************************************************/
+bool
+PuzzleQueue::needsRefill() const noexcept
+{
+    for (size_t clues{ 0 }; clues <= BitBoard::cells; ++clues)
+        if (_requested[clues] && _rings[clues].size() < depth)
+            return true;
+    return false;
+}
+
+/*****************************************************************************/
+void
+PuzzleQueue::notify() noexcept
+{
+    // Taking the lock avoids a lost wake-up between a predicate check and the wait
+    { std::lock_guard<std::mutex> lock{ _mutex }; }
+    _cv.notify_all();
+}
+
+/*****************************************************************************/
+void
+PuzzleQueue::produce() noexcept
+{
+    std::mt19937 rng{ std::random_device{}() };
+
+    // Pool of full grids the puzzles are taken from (same as the former synchronous generation)
+    std::vector<BitBoard::Packed> pool;
+    {
+        TRACE_SCOPE("puzzles pool");
+        const auto start{ std::chrono::steady_clock::now() };
+
+        if (auto model{ ecv::Sudoku::generate() }; nullptr != model)
+            for (const auto& sol : model->solve(pool_size))
+                pool.push_back(BitBoard::pack(BitBoard::fromData(model->apply(sol))));
+
+        _pool_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    }
+
+    // Nothing to produce from, do not let consumers wait forever
+    if (std::empty(pool)) {
+        _stop = true;
+        notify();
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> pick{ 0, std::size(pool) - 1 };
+    std::array<size_t, BitBoard::cells>   idxes;
+    std::iota(std::begin(idxes), std::end(idxes), 0);
+
+    while (!_stop) {
+        const auto start{ std::chrono::steady_clock::now() };
+        auto       produced{ false };
+
+        for (size_t clues{ 0 }; clues <= BitBoard::cells && !_stop; ++clues) {
+            if (!_requested[clues] || _rings[clues].size() >= depth)
+                continue;
+
+            // Uncover 'clues' random cells of a random grid
+            TRACE_SCOPE("produce puzzle");
+            auto board{ BitBoard::unpack(pool[pick(rng)]) };
+            std::shuffle(std::begin(idxes), std::end(idxes), rng);
+            for (size_t k{ clues }; k < BitBoard::cells; ++k)
+                board[idxes[k]] = 0;
+
+            _rings[clues].push(BitBoard::pack(board));
+            ++_produced;
+            produced = true;
+        }
+
+        if (produced) {
+            _busy_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+            notify();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{ _mutex };
+        _cv.wait(lock, [this]() { return _stop || needsRefill(); });
+    }
+}
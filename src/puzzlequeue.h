@@ -0,0 +1,116 @@
+#ifndef PUZZLEQUEUE_H
+#define PUZZLEQUEUE_H
+
+#include "bitboard.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/*!
+ * \brief The PuzzleQueue class keeps ready-made random puzzles, per number of uncovered cells,
+ * topped up by a background producer thread.
+ *
+ * Puzzles are stored in bounded single-producer/single-consumer lock-free rings, so taking a
+ * ready puzzle never blocks. Only the clue counts that have been requested are produced.
+ */
+class PuzzleQueue
+{
+public:
+    static constexpr size_t depth{ 16 };         /*!< Maximum number of puzzles per clue count */
+    static constexpr size_t pool_size{ 10000 };  /*!< Number of solutions the puzzles come from */
+
+    /*!
+     * \brief The Metrics struct exposes the state of the queue for a clue count
+     */
+    struct Metrics
+    {
+        size_t depth;      /*!< Puzzles ready to be served */
+        size_t produced;   /*!< Puzzles produced (all clue counts) */
+        size_t served;     /*!< Puzzles served (all clue counts) */
+        size_t misses;     /*!< Requests that had to wait for the producer */
+        double refillRate; /*!< Puzzles produced per second of refill (pool build excluded) */
+        double poolMs;     /*!< Time spent building the pool of solutions */
+    };
+
+public:
+    PuzzleQueue() noexcept;
+    ~PuzzleQueue() noexcept;
+
+    PuzzleQueue(const PuzzleQueue&) = delete;
+    PuzzleQueue& operator=(const PuzzleQueue&) = delete;
+
+    /*!
+     * \brief request Ask the producer to keep puzzles ready for a clue count
+     * \param clues the number of uncovered cells (clamped to 81)
+     */
+    void request(size_t clues) noexcept;
+
+    /*!
+     * \brief take Get a puzzle (waits for the producer only if none is ready)
+     * \param clues the number of uncovered cells (clamped to 81)
+     */
+    BitBoard::Board take(size_t clues) noexcept;
+
+    Metrics metrics(size_t clues) const noexcept;
+
+private:
+    /*!
+     * \brief The Ring class is a bounded single-producer/single-consumer lock-free queue
+     */
+    class Ring
+    {
+    public:
+        bool push(const BitBoard::Packed& p) noexcept
+        {
+            const auto tail{ _tail.load(std::memory_order_relaxed) };
+            if (tail - _head.load(std::memory_order_acquire) == depth)
+                return false;
+            _buf[tail % depth] = p;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(BitBoard::Packed& p) noexcept
+        {
+            const auto head{ _head.load(std::memory_order_relaxed) };
+            if (head == _tail.load(std::memory_order_acquire))
+                return false;
+            p = _buf[head % depth];
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const noexcept
+        {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::array<BitBoard::Packed, depth> _buf;
+        alignas(64) std::atomic<size_t> _head{ 0 };
+        alignas(64) std::atomic<size_t> _tail{ 0 };
+    };
+
+private:
+    void produce() noexcept;
+    bool needsRefill() const noexcept;
+    void notify() noexcept;
+
+private:
+    std::array<Ring, BitBoard::cells + 1>              _rings;
+    std::array<std::atomic<bool>, BitBoard::cells + 1> _requested{};
+
+    std::atomic<bool>     _stop{ false };
+    std::atomic<size_t>   _produced{ 0 }, _served{ 0 }, _misses{ 0 };
+    std::atomic<uint64_t> _busy_us{ 0 }; /*!< Time spent refilling the rings */
+    std::atomic<uint64_t> _pool_us{ 0 }; /*!< Time spent building the pool */
+
+    mutable std::mutex      _mutex; /*!< Only used to sleep/wake up (producer idle or miss) */
+    std::condition_variable _cv;
+    std::thread             _producer;
+};
+
+#endif // PUZZLEQUEUE_H
@@ -0,0 +1,124 @@
+/**
+ * @file puzzles.cpp
+ * @brief Implementation of \a puzzles.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "puzzles.h"
+
+// Standard headers
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/*!
+ * \brief make Create a library entry, checking at compile time that the puzzle has exactly one
+ * solution (the throw makes the constant evaluation, and thus the build, fail otherwise).
+ */
+constexpr Puzzle
+make(const char* str)
+{
+    const auto board{ BitBoard::parse(str) };
+
+    BitBoard solver{ board };
+    if (!solver.valid())
+        throw std::logic_error("Invalid puzzle");
+    if (1 != solver.solve(2))
+        throw std::logic_error("Puzzle without a unique solution");
+
+    return Puzzle{ BitBoard::pack(board), BitBoard::pack(solver.board()) };
+}
+
+// clang-format off
+constexpr const char* _library[]{
+    "510090000740805000900102058000904081300060005190203060003500006800000007000600000",
+    "900030470000900300000006000003680500020070000040000007462351008308000004000007006",
+    "000040009004000800020800056015600040000001020000900108070468031800107000060009000",
+    "200040090050120047407305000900000680840050000700000009080006000000401006569000130",
+    "008300009000000037103507008016802040040000000300964005000400000060020890400600302",
+    "600001003098250000503060800000900400120480600005030000200000004001348070000002300",
+    "000010000500000041009850060130020080000031009000600710091002030362000000740008000",
+    "049700000072104003030200907020009008000400200097000006000008500004006079080000004",
+    "000060083001000056630080700008020095007005002060103040000009504005006278000000931",
+    "300800005015002003802015794908500420000000000106000030630000040080000060000769000",
+    "018006009000004600200053700605240901080060000020309007009000126801900000000000000",
+    "200006009907500000000700002091000308300600000400105000000001705500300180003000020",
+    "305000617000004020682000000020006000050240000000500093001003085068090000030052009",
+    "710090030000005400000007609530000100201800063009010280000000001026001907000520340",
+    "006080953004900010010007000000000200003000007600000040807305402502000070000400080",
+    "010006000007030000500000800000008090008001004150793060020409050000070000845010907",
+    "000500000900340027073102465002000010580009300400050000730005008000030000000407000",
+    "061900702007104000000680040000009010210850070034002059080000005100000498003500000",
+    "020006000007804003000000010706900500200170800039465000560080009300009062070002305",
+    "703008961900631040000000050000984700005010000000500190086000004000007023000800019",
+    "000000835000300910000928674050040007087000040000000083540000701708002490902007000",
+    "030102850201000300000300900300000000069021000025400070000208700900570104002040000",
+    "648090700127450000000060400810509030000018090090000061000080000000046375000721000",
+    "890003100705000000102504080327001006600200051050006200006008004010600000080302600",
+    "789501000021006090030020000000080900000050480000040310302000050500702031017300600",
+    "000200000068300720020814900430001090000000005007000000006007019000060000900180607",
+    "009000007060050008010300000000067800900400061640500000490100006000000500082040700",
+    "387001000920000800006000027600070000100900005095060078003582140200090700000000000",
+    "009000167000000040007840050000001000090000470001370000004005006503702080006039005",
+    "000100090002064001001090600490070008007000034320010000710600942000240800200930700",
+};
+// clang-format on
+
+/*!
+ * \brief entry Entry of the library. Each one is a constant evaluation of its own, so that the
+ * compiler's evaluation limit applies per puzzle rather than to the whole library.
+ */
+template<size_t I>
+constexpr Puzzle entry{ make(_library[I]) };
+
+template<size_t... I>
+constexpr std::array<Puzzle, sizeof...(I)>
+library(std::index_sequence<I...>) noexcept
+{
+    return { entry<I>... };
+}
+
+constexpr auto _puzzles{ library(std::make_index_sequence<std::size(_library)>{}) };
+
+} // namespace
+
+/*****************************************************************************/
+size_t
+puzzlesCount() noexcept
+{
+    return std::size(_puzzles);
+}
+
+/*****************************************************************************/
+const Puzzle&
+puzzle(size_t idx) noexcept
+{
+    return _puzzles[idx % std::size(_puzzles)];
+}
+
+/*****************************************************************************/
+const Puzzle&
+dailyPuzzle() noexcept
+{
+    const auto days{ std::chrono::duration_cast<std::chrono::hours>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count() /
+                     24 };
+
+    return puzzle(static_cast<size_t>(days));
+}
+
+/*****************************************************************************/
+const Puzzle*
+findPuzzle(const BitBoard::Board& board) noexcept
+{
+    const auto packed{ BitBoard::pack(board) };
+    for (const auto& p : _puzzles)
+        if (p.puzzle == packed)
+            return &p;
+
+    return nullptr;
+}
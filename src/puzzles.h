@@ -0,0 +1,43 @@
+#ifndef PUZZLES_H
+#define PUZZLES_H
+
+#include "bitboard.h"
+
+/*!
+ * \brief The Puzzle struct is an entry of the embedded puzzles library
+ *
+ * Both the puzzle and its (unique) solution are computed at compile time.
+ */
+struct Puzzle
+{
+    BitBoard::Packed puzzle;
+    BitBoard::Packed solution;
+};
+
+/*!
+ * \brief puzzlesCount Get the number of puzzles in the embedded library
+ */
+size_t
+puzzlesCount() noexcept;
+
+/*!
+ * \brief puzzle Get a puzzle of the embedded library
+ * \param idx the index of the puzzle (modulo puzzlesCount())
+ */
+const Puzzle&
+puzzle(size_t idx) noexcept;
+
+/*!
+ * \brief dailyPuzzle Get the puzzle of the day
+ */
+const Puzzle&
+dailyPuzzle() noexcept;
+
+/*!
+ * \brief findPuzzle Get the library entry of a puzzle
+ * \return the entry, nullptr if the puzzle is not part of the library
+ */
+const Puzzle*
+findPuzzle(const BitBoard::Board& board) noexcept;
+
+#endif // PUZZLES_H
@@ -0,0 +1,68 @@
+/**
+ * @file solutionstore.cpp
+ * @brief Implementation of \a solutionstore.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "solutionstore.h"
+
+/*****************************************************************************/
+void
+SolutionStore::reset(const BitBoard::Board& puzzle) noexcept
+{
+    clear();
+
+    _puzzle = puzzle;
+    for (size_t k{ 0 }; k < BitBoard::cells; ++k)
+        if (0 == _puzzle[k])
+            _free.push_back(static_cast<uint8_t>(k));
+
+    _stride = (std::size(_free) + 1) / 2;
+}
+
+/*****************************************************************************/
+void
+SolutionStore::clear() noexcept
+{
+    _puzzle = BitBoard::Board{};
+    _free.clear();
+    _stride = 0;
+    _count = 0;
+
+    // Release the memory, the store may have held a million solutions
+    std::vector<uint8_t>{}.swap(_data);
+}
+
+/*****************************************************************************/
+void
+SolutionStore::reserve(size_t count)
+{
+    _data.reserve(count * _stride);
+}
+
+/*****************************************************************************/
+void
+SolutionStore::push(const BitBoard::Board& solution)
+{
+    const auto offset{ std::size(_data) };
+    _data.resize(offset + _stride, 0);
+
+    for (size_t i{ 0 }; i < std::size(_free); ++i)
+        _data[offset + i / 2] |= static_cast<uint8_t>((solution[_free[i]] & 0xF) << (4 * (i % 2)));
+
+    ++_count;
+}
+
+/*****************************************************************************/
+BitBoard::Board
+SolutionStore::at(size_t idx) const noexcept
+{
+    auto       ret{ _puzzle };
+    const auto offset{ idx * _stride };
+
+    for (size_t i{ 0 }; i < std::size(_free); ++i)
+        ret[_free[i]] = (_data[offset + i / 2] >> (4 * (i % 2))) & 0xF;
+
+    return ret;
+}
@@ -0,0 +1,58 @@
+#ifndef SOLUTIONSTORE_H
+#define SOLUTIONSTORE_H
+
+#include "bitboard.h"
+
+#include <vector>
+
+/*!
+ * \brief The SolutionStore class keeps the solutions of a puzzle in a single contiguous buffer.
+ *
+ * Each solution is stored as a delta against the puzzle : only the values of the cells that are
+ * empty in the puzzle, one nibble each. Any solution can be retrieved in constant time.
+ */
+class SolutionStore
+{
+public:
+    SolutionStore() noexcept = default;
+
+    /*!
+     * \brief reset Clear the store and set the puzzle the next solutions belong to
+     */
+    void reset(const BitBoard::Board& puzzle) noexcept;
+
+    void clear() noexcept;
+
+    /*!
+     * \brief reserve Reserve room for a number of solutions
+     */
+    void reserve(size_t count);
+
+    /*!
+     * \brief push Add a solution of the puzzle
+     */
+    void push(const BitBoard::Board& solution);
+
+    /*!
+     * \brief at Get a solution
+     * \param idx the index of the solution (must be lower than size())
+     */
+    BitBoard::Board at(size_t idx) const noexcept;
+
+    size_t size() const noexcept { return _count; }
+    bool   empty() const noexcept { return 0 == _count; }
+
+    /*!
+     * \brief memory Get the number of bytes used to store the solutions
+     */
+    size_t memory() const noexcept { return _data.capacity() + _free.capacity(); }
+
+private:
+    BitBoard::Board      _puzzle{};
+    std::vector<uint8_t> _free;        /*!< Indexes of the empty cells of the puzzle */
+    size_t               _stride{ 0 }; /*!< Bytes per solution */
+    size_t               _count{ 0 };
+    std::vector<uint8_t> _data; /*!< Solutions, _stride bytes each */
+};
+
+#endif // SOLUTIONSTORE_H
@@ -0,0 +1,108 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation of \a trace.h
+ * @author lhm
+ */
+
+// Project's headers
+#include "trace.h"
+
+#ifdef ECV_SUDOKU_TRACE
+
+// Standard headers
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+const auto origin{ std::chrono::steady_clock::now() }; /*!< Timestamps are relative to it */
+
+struct Event
+{
+    const char* name;
+    long long   ts, dur; /*!< Microseconds */
+    size_t      tid;
+};
+
+/*!
+ * \brief The Recorder class gathers the events and writes them when the program exits.
+ *
+ * Only the latest max_events events are kept, so that a long session does not grow the buffer
+ * without limit (the number of dropped events is written along with the trace).
+ */
+class Recorder
+{
+public:
+    static constexpr size_t max_events{ 1 << 20 };
+
+public:
+    ~Recorder() noexcept
+    {
+        const char*   path{ std::getenv("ECV_SUDOKU_TRACE_FILE") };
+        std::ofstream out{ nullptr != path ? path : "ecv-sudoku-trace.json" };
+
+        // Oldest event first
+        const auto kept{ std::size(_events) };
+        const auto first{ _count - kept };
+
+        out << "{\"traceEvents\":[";
+        for (size_t i{ 0 }; i < kept; ++i) {
+            const auto& e{ _events[(first + i) % max_events] };
+            out << (0 == i ? "" : ",") << "\n{\"name\":\"" << e.name
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":" << e.ts
+                << ",\"dur\":" << e.dur << '}';
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":" << first << "}}\n";
+    }
+
+    void add(const Event& e)
+    {
+        std::lock_guard<std::mutex> lock{ _mutex };
+        if (std::size(_events) < max_events)
+            _events.push_back(e);
+        else
+            _events[_count % max_events] = e;
+        ++_count;
+    }
+
+private:
+    std::mutex         _mutex;
+    std::vector<Event> _events;     /*!< Ring buffer of the latest events */
+    size_t             _count{ 0 }; /*!< Number of events recorded */
+};
+
+Recorder&
+recorder()
+{
+    static Recorder r;
+    return r;
+}
+
+size_t
+threadId() noexcept
+{
+    static std::atomic<size_t> next{ 1 };
+    thread_local const size_t  id{ next++ };
+    return id;
+}
+
+} // namespace
+
+/*****************************************************************************/
+TraceSpan::~TraceSpan() noexcept
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const auto end{ std::chrono::steady_clock::now() };
+
+    recorder().add(Event{ _name,
+                          duration_cast<microseconds>(_start - origin).count(),
+                          duration_cast<microseconds>(end - _start).count(),
+                          threadId() });
+}
+
+#endif // ECV_SUDOKU_TRACE
@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*!
+ * \file trace.h
+ * \brief Scoped timing spans exported as a Chrome/Perfetto trace (chrome://tracing, ui.perfetto.dev)
+ *
+ * Tracing is only compiled in with ECV_SUDOKU_TRACE (CMake option of the same name), otherwise
+ * TRACE_SCOPE expands to nothing. The trace is written at exit to the file named by the
+ * ECV_SUDOKU_TRACE_FILE environment variable (ecv-sudoku-trace.json by default).
+ */
+
+#ifdef ECV_SUDOKU_TRACE
+
+#include <chrono>
+
+/*!
+ * \brief The TraceSpan class records the duration of its scope
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* name) noexcept
+      : _name{ name }
+      , _start{ std::chrono::steady_clock::now() }
+    {}
+
+    ~TraceSpan() noexcept;
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* const                           _name; /*!< Must be a string literal */
+    const std::chrono::steady_clock::time_point _start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) const TraceSpan TRACE_CONCAT(_trace_span_, __LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif // ECV_SUDOKU_TRACE
+
+#endif // TRACE_H